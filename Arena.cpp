@@ -0,0 +1,53 @@
+#include "Arena.h"
+
+#include <cstdint>
+
+Arena::Arena(std::size_t blockSize)
+    : blockSize_(blockSize > 0 ? blockSize : 1) {}
+
+Arena::~Arena() {
+    for (Block& b : blocks_) {
+        ::operator delete(b.data);
+    }
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t align) {
+    if (bytes == 0) bytes = 1;
+
+    // try current block first, then move on to the next retained one
+    while (curBlock_ < blocks_.size()) {
+        Block& b = blocks_[curBlock_];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(b.data);
+        std::size_t aligned = static_cast<std::size_t>(
+            ((base + offset_ + align - 1) & ~(std::uintptr_t)(align - 1)) - base);
+        if (aligned + bytes <= b.size) {
+            offset_ = aligned + bytes;
+            bytesUsed_ += bytes;
+            ++allocations_;
+            return b.data + aligned;
+        }
+        ++curBlock_;
+        offset_ = 0;
+    }
+
+    // no retained block fits, oversized requests get a block of their own
+    std::size_t size = blockSize_;
+    if (bytes + align > size) size = bytes + align;
+
+    Block nb;
+    nb.data = static_cast<char*>(::operator new(size));
+    nb.size = size;
+    blocks_.push_back(nb);
+    bytesReserved_ += size;
+
+    curBlock_ = blocks_.size() - 1;
+    offset_   = 0;
+    return allocate(bytes, align);
+}
+
+void Arena::reset() {
+    curBlock_  = 0;
+    offset_    = 0;
+    bytesUsed_ = 0;
+    allocations_ = 0;
+}
@@ -0,0 +1,69 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <cstddef> // std::size_t
+#include <memory_resource>
+
+// Arena: monotonic bump allocator for per-seed objects
+// - Jobs, servers and preference lists of one seed are placed here
+// - Nothing is freed one by one; reset() rewinds the arena in O(1)
+//   and keeps its blocks for the next seed
+// - Objects created here are never destroyed, so anything they own
+//   must live in the same arena (see Server::assignedJobs_)
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(std::size_t blockSize = 1 << 20);
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t align);
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* p = allocate(sizeof(T), alignof(T));
+        return new (p) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T* allocArray(std::size_t n) {
+        if (n == 0) return nullptr;
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // rewind to the first block, blocks are kept for reuse
+    void reset();
+
+    std::size_t bytesUsed() const { return bytesUsed_; }
+    std::size_t bytesReserved() const { return bytesReserved_; }
+    std::size_t allocations() const { return allocations_; } // since the last reset()
+
+private:
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    std::size_t blockSize_;
+    std::size_t curBlock_ = 0;
+    std::size_t offset_   = 0;
+
+    std::size_t bytesUsed_     = 0;
+    std::size_t bytesReserved_ = 0;
+    std::size_t allocations_   = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        return allocate(bytes, align);
+    }
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+#endif // ARENA_H
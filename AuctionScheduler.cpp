@@ -0,0 +1,196 @@
+#include "AuctionScheduler.h"
+#include "Job.h"
+#include "Server.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// min-heap on unit bid: the lowest holder is evicted first
+bool bidAbove(const std::pair<double, int>& a, const std::pair<double, int>& b) {
+    return a.first > b.first;
+}
+
+} // namespace
+
+// what a job of this size must beat per unit: nothing while it still fits
+// into the capacity the current holders leave over, else the clock price
+double AuctionScheduler::unitPrice(int si, int demand) const {
+    return (freeCap_[si] - used_[si] >= demand) ? 0.0 : price_[si];
+}
+
+void AuctionScheduler::bid(int b, double eps) {
+    Bidder& bidder = bidders_[b];
+
+    // S1. best and second best net value, candidates come in value order
+    double best = 0.0, second = 0.0; // staying out is worth 0
+    int bestSi = -1;
+    for (int c = bidder.first; c < bidder.last; ++c) {
+        int value = cand_[c].first;
+        if (value <= second) break; // net <= value, nothing left can place
+        int si = cand_[c].second;
+        double net = value - unitPrice(si, bidder.demand) * bidder.demand;
+        if (net > best) {
+            second = best;
+            best = net;
+            bestSi = si;
+        } else if (net > second) {
+            second = net;
+        }
+    }
+    if (bestSi < 0) return; // priced out everywhere, sits this batch out
+
+    // S2. bid, the server evicts its lowest unit bids until it fits
+    ++bids_;
+    double unitBid = unitPrice(bestSi, bidder.demand) + (best - second + eps) / bidder.demand;
+    auto& heap = held_[bestSi];
+    heap.emplace_back(unitBid, b);
+    std::push_heap(heap.begin(), heap.end(), bidAbove);
+    bidder.server = bestSi;
+    used_[bestSi] += bidder.demand;
+
+    while (used_[bestSi] > freeCap_[bestSi]) {
+        std::pop_heap(heap.begin(), heap.end(), bidAbove);
+        Bid out = heap.back();
+        heap.pop_back();
+        price_[bestSi] = std::max(price_[bestSi], out.first);
+        used_[bestSi] -= bidders_[out.second].demand;
+        bidders_[out.second].server = -1;
+        unassigned_.push_back(out.second);
+    }
+}
+
+void AuctionScheduler::runBatch(std::vector<Job*>& jobs,
+                                std::vector<Server*>& servers,
+                                int currentTime,
+                                Simulation* sim)
+{
+    // S1. free capacity + bidders that fit somewhere, prices start at 0 every batch
+    int maxId = 0;
+    int maxFree = 0;
+    for (Server* s : servers) {
+        if (!s) continue;
+        maxId = std::max(maxId, s->id());
+        maxFree = std::max(maxFree, s->freeCapacity());
+    }
+
+    if (maxFree <= 0) return;
+
+    serverIndexById_.assign(maxId + 1, -1);
+    freeCap_.assign(servers.size(), 0);
+    used_.assign(servers.size(), 0);
+    price_.assign(servers.size(), 0.0);
+    held_.resize(servers.size());
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        if (!servers[si]) continue;
+        serverIndexById_[servers[si]->id()] = static_cast<int>(si);
+        freeCap_[si] = servers[si]->freeCapacity();
+    }
+
+    bidders_.clear();
+    cand_.clear();
+    int maxLen = 0;
+    for (Job* job : jobs) {
+        if (!job || !job->isWaiting() || job->reportedDemand() <= 0) continue;
+        int demand = job->reportedDemand();
+        if (demand > maxFree) continue;
+
+        int L = job->numPreferences();
+        const int* prefs = job->preferences();
+        int first = static_cast<int>(cand_.size());
+        for (int k = 0; k < L; ++k) {
+            int sid = prefs[k];
+            int si = (sid >= 0 && sid <= maxId) ? serverIndexById_[sid] : -1;
+            if (si < 0 || freeCap_[si] < demand) continue;
+            cand_.emplace_back(L - k, si);
+        }
+        if (static_cast<int>(cand_.size()) == first) continue; // fits nowhere it asks for
+        bidders_.push_back({job, demand, -1, first, static_cast<int>(cand_.size())});
+        maxLen = std::max(maxLen, L);
+    }
+    if (bidders_.empty()) return;
+
+    // S2. epsilon-scaling phases
+    double epsMin = 1.0 / (bidders_.size() + 1);
+    for (double eps = std::max(maxLen / 4.0, epsMin); ; eps = std::max(eps / 4.0, epsMin)) {
+        ++phases_;
+        for (auto& h : held_) h.clear();
+        std::fill(used_.begin(), used_.end(), 0);
+        unassigned_.clear();
+        for (int b = static_cast<int>(bidders_.size()) - 1; b >= 0; --b) {
+            bidders_[b].server = -1;
+            unassigned_.push_back(b);
+        }
+        while (!unassigned_.empty()) {
+            int b = unassigned_.back();
+            unassigned_.pop_back();
+            bid(b, eps);
+        }
+        if (eps <= epsMin) break;
+    }
+
+    // S3. winners run, pay the lowest unit bid held at their server; a winner
+    //     that doesn't fit (under-reported demand) fails and pays nothing.
+    //     Not the clock price: that carries early-phase evictions and skips
+    //     the leftover-capacity bids, so it can exceed a winner's value
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        Server* server = servers[si];
+        double clearing = held_[si].empty() ? 0.0 : held_[si].front().first; // min-heap
+        for (const Bid& h : held_[si]) {
+            Job* job = bidders_[h.second].job;
+            if (!server->accept(job)) {
+                job->markFailed(currentTime);
+                continue;
+            }
+            job->markRunning(currentTime);
+            if (sim) sim->logJobStart(job, server, currentTime);
+
+            double payment = clearing * job->reportedDemand();
+            ++winners_;
+            paid_ += payment;
+            paidUnits_ += job->reportedDemand();
+            if (logPayments_) {
+                PaymentRecord r;
+                r.time = currentTime;
+                r.jobId = job->id();
+                r.serverId = server->id();
+                r.trueDemand = job->trueDemand();
+                r.reportedDemand = job->reportedDemand();
+                r.unitPrice = clearing;
+                r.payment = payment;
+                payments_.push_back(r);
+            }
+        }
+    }
+}
+
+void AuctionScheduler::resetStats() {
+    payments_.clear();
+    bids_      = 0;
+    phases_    = 0;
+    winners_   = 0;
+    paid_      = 0.0;
+    paidUnits_ = 0;
+}
+
+void AuctionScheduler::printStats() const {
+    std::cout << "Auction: " << winners_ << " winners, " << bids_ << " bids in "
+              << phases_ << " eps phases, paid " << paid_ << " ("
+              << (paidUnits_ > 0 ? paid_ / paidUnits_ : 0.0) << " per unit)\n";
+}
+
+MemUsage AuctionScheduler::scratchUsage() const {
+    MemUsage u;
+    u.addVector(payments_);
+    u.addVector(bidders_);
+    u.addVector(serverIndexById_);
+    u.addVector(freeCap_);
+    u.addVector(used_);
+    u.addVector(price_);
+    u.addVector(held_);
+    u.addVector(unassigned_);
+    u.addVector(cand_);
+    return u;
+}
@@ -0,0 +1,93 @@
+#ifndef AUCTION_SCHEDULER_H
+#define AUCTION_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "Simulation.h"
+
+#include <vector>
+#include <utility>
+
+// one placed winner of one batch, for payment logging
+struct PaymentRecord {
+    int time     = 0;
+    int jobId    = -1;
+    int serverId = -1;
+    int trueDemand     = 0;
+    int reportedDemand = 0;
+    double unitPrice = 0.0; // lowest unit bid held at the server
+    double payment   = 0.0; // unitPrice * reportedDemand
+};
+
+// Ascending auction for free server capacity (Bertsekas-style bidding)
+// - A job values the k-th server on its list at L - k (L = list length) and
+//   pays unitPrice * reportedDemand there, so its net value is
+//   (L - k) - price[s] * demand
+// - An unassigned job bids on its best server, raising the unit price by
+//   (best - second best + eps) / demand; the server keeps the highest unit
+//   bids that fit its free capacity and evicts the rest. The server price is
+//   the highest evicted unit bid (the clock only goes up); a job that still
+//   fits into the capacity left over by the holders pays no price there, so
+//   evictions of large jobs don't leave capacity idle
+// - Jobs with no positive net value anywhere sit the batch out
+// - Each bidder's list is cut down once per batch to the servers it fits on,
+//   under overload only a few servers have room and every phase re-bids
+// - Epsilon scaling: phases with eps = maxValue/4, /4 each phase, down to
+//   1/(jobs+1); assignments restart each phase, prices carry over, so the
+//   late phases only fix up a near-final assignment
+// - Winners pay the lowest unit bid their server holds at the end (uniform
+//   per server); a final-phase bid costs at most value + eps, so no winner
+//   pays more than its value plus the last eps. Logged when
+//   setPaymentLogging(true)
+class AuctionScheduler : public Scheduler {
+public:
+    AuctionScheduler() = default;
+    ~AuctionScheduler() override = default;
+
+    void runBatch(std::vector<Job*>& jobs,
+                  std::vector<Server*>& servers,
+                  int currentTime,
+                  Simulation *sim) override;
+
+    // keep one PaymentRecord per winner until resetStats()
+    void setPaymentLogging(bool on) { logPayments_ = on; }
+    const std::vector<PaymentRecord>& payments() const { return payments_; }
+
+    void resetStats() override;
+    void printStats() const override;
+    MemUsage scratchUsage() const override;
+
+private:
+    struct Bidder {
+        Job* job;
+        int demand;
+        int server;  // server index currently holding the job, -1 = none
+        int first;   // candidates in cand_[first, last)
+        int last;
+    };
+    using Candidate = std::pair<int, int>; // value L - k, server index
+    using Bid = std::pair<double, int>; // unit bid, bidder index
+
+    bool logPayments_ = false;
+    std::vector<PaymentRecord> payments_;
+
+    // scratch, kept across batches
+    std::vector<Bidder> bidders_;
+    std::vector<int> serverIndexById_;
+    std::vector<int> freeCap_;
+    std::vector<int> used_;
+    std::vector<double> price_;
+    std::vector<std::vector<Bid>> held_; // per server, min-heap on unit bid
+    std::vector<int> unassigned_;
+    std::vector<Candidate> cand_; // per bidder, servers it fits on in list order
+
+    long long bids_    = 0;
+    long long phases_  = 0;
+    long long winners_ = 0;   // placed winners only, they are the ones who pay
+    double paid_       = 0.0;
+    long long paidUnits_ = 0;
+
+    double unitPrice(int si, int demand) const;
+    void bid(int b, double eps);
+};
+
+#endif // AUCTION_SCHEDULER_H
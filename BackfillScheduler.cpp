@@ -0,0 +1,107 @@
+#include "BackfillScheduler.h"
+#include "Job.h"
+#include "Server.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+void BackfillScheduler::runBatch(std::vector<Job*>& jobs,
+                                 std::vector<Server*>& servers,
+                                 int currentTime,
+                                 Simulation* sim)
+{
+    // S1. skylines: free now, plus what each running job gives back when it
+    //     is removed (first tick with elapsed >= duration, never before the next)
+    skylines_.resize(servers.size());
+    freeIndex_.build(servers);
+    sizeIndex_.clear();
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        Server* s = servers[si];
+        if (!s) continue;
+        sizeIndex_.set(static_cast<int>(si), s->capacity());
+        releases_.clear();
+        for (Job* job : s->assignedJobs()) {
+            if (!job || !job->isRunning()) continue;
+            int release = std::max(job->startTime() + job->duration(), currentTime + 1);
+            releases_.emplace_back(release, job->trueDemand());
+        }
+        skylines_[si].build(currentTime, s->freeCapacity(), releases_);
+    }
+
+    // S2. queue order: start what fits without touching a reservation,
+    //     reserve for blocked jobs
+    bool blocked = false;
+    for (Job* job : jobs) {
+        if (!job || !job->isWaiting()) continue;
+
+        int demand = job->reportedDemand();
+        if (demand <= 0) continue;
+        int length = std::max(job->duration(), 1);
+        int end = currentTime + length;
+
+        // best-fit among servers that stay free enough for the whole run
+        int best = freeIndex_.bestFit(demand, [&](int si) {
+            return skylines_[si].minFree(currentTime, end) >= demand;
+        });
+
+        if (best >= 0) {
+            Server* server = servers[best];
+            if (server->accept(job)) {
+                job->markRunning(currentTime);
+                if (sim) sim->logJobStart(job, server, currentTime);
+                skylines_[best].reserve(currentTime, end, job->trueDemand());
+                ++started_;
+                if (blocked) ++backfilled_;
+            } else {
+                job->markFailed(currentTime);
+            }
+            freeIndex_.set(best, server->freeCapacity());
+            continue;
+        }
+
+        if (blocked && mode_ == Mode::Easy) continue;
+
+        // earliest start anywhere, then hold that capacity
+        int bestStart = INT_MAX;
+        for (auto it = sizeIndex_.from(demand); it != sizeIndex_.end(); ++it) {
+            int si = it->second;
+            int t = skylines_[si].earliestFit(currentTime, length, demand);
+            if (t >= 0 && (t < bestStart || (t == bestStart && si < best))) {
+                bestStart = t;
+                best = si;
+            }
+        }
+        if (best < 0) continue; // larger than any server, nothing to hold
+        skylines_[best].reserve(bestStart, bestStart + length, demand);
+        ++reserved_;
+        blocked = true;
+    }
+}
+
+void BackfillScheduler::resetStats() {
+    started_    = 0;
+    backfilled_ = 0;
+    reserved_   = 0;
+}
+
+void BackfillScheduler::printStats() const {
+    std::cout << (mode_ == Mode::Easy ? "EASY" : "Conservative") << " backfilling: "
+              << started_ << " jobs started, " << backfilled_ << " of them backfilled, "
+              << reserved_ << " reservations\n";
+}
+
+MemUsage BackfillScheduler::scratchUsage() const {
+    MemUsage u;
+    u.addVector(skylines_);
+    u.addVector(releases_);
+    u += freeIndex_.usage();
+    u += sizeIndex_.usage();
+    for (const Skyline& sky : skylines_) {
+        // map nodes, approximate
+        u.allocs += static_cast<long long>(sky.breakpoints());
+        u.bytes  += static_cast<long long>(sky.breakpoints() * (2 * sizeof(int) + 4 * sizeof(void*)));
+    }
+    return u;
+}
@@ -0,0 +1,55 @@
+#ifndef BACKFILL_SCHEDULER_H
+#define BACKFILL_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "Simulation.h"
+#include "Skyline.h"
+#include "CapacityIndex.h"
+
+#include <vector>
+
+// Backfilling on top of best-fit, using the known job durations
+// - Every server gets a Skyline of its future free capacity, built from the
+//   running jobs' finish ticks at the start of each batch
+// - Jobs are taken in queue (arrival) order; a job starts now on the
+//   best-fit server whose skyline holds its reported demand for its whole
+//   duration, so it never delays a reservation made earlier in the batch.
+//   Candidates come from a CapacityIndex on free capacity now (reservations
+//   never start now, so that is also the skyline's first step); only servers
+//   with enough free capacity get their skylines walked, best fit first
+// - A job that cannot start gets a reservation at its earliest-fit tick
+//   (lowest server index on ties), searched over servers large enough to
+//   ever hold it: EASY reserves only for the first blocked job, Conservative
+//   for every blocked job
+// - Reservations only shape this batch; the next batch plans again from
+//   the servers' real state
+class BackfillScheduler : public Scheduler {
+public:
+    enum class Mode { Easy, Conservative };
+
+    explicit BackfillScheduler(Mode mode = Mode::Easy) : mode_(mode) {}
+    ~BackfillScheduler() override = default;
+
+    void runBatch(std::vector<Job*>& jobs,
+                  std::vector<Server*>& servers,
+                  int currentTime,
+                  Simulation *sim) override;
+
+    void resetStats() override;
+    void printStats() const override;
+    MemUsage scratchUsage() const override;
+
+private:
+    Mode mode_;
+
+    std::vector<Skyline> skylines_;                // per server index
+    std::vector<std::pair<int, int>> releases_;    // scratch for Skyline::build
+    CapacityIndex freeIndex_;                      // keyed on free capacity now
+    CapacityIndex sizeIndex_;                      // keyed on total capacity
+
+    long long started_    = 0;
+    long long backfilled_ = 0; // started behind a blocked job
+    long long reserved_   = 0;
+};
+
+#endif // BACKFILL_SCHEDULER_H
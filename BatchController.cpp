@@ -0,0 +1,59 @@
+#include "BatchController.h"
+
+#include <algorithm>
+
+BatchController::BatchController(const BatchPolicy& policy, int batchSize)
+    : policy_(policy),
+      window_(batchSize > 0 ? batchSize : 1)
+{
+    if (policy_.minBatch < 1) policy_.minBatch = 1;
+    if (policy_.maxBatch < policy_.minBatch) policy_.maxBatch = policy_.minBatch;
+    if (policy_.adaptive) {
+        window_ = std::min(std::max(window_, policy_.minBatch), policy_.maxBatch);
+    }
+    // so the very first tick can run a batch
+    lastBatchTime_ = -window_;
+}
+
+void BatchController::onArrivals(int count, int currentTime) {
+    if (count <= 0) return;
+    if (!arrived_) oldestPending_ = currentTime;
+    arrived_ = true;
+}
+
+void BatchController::onCapacityFreed(int amount) {
+    if (amount > 0) freed_ = true;
+}
+
+bool BatchController::due(int currentTime) const {
+    if (!policy_.adaptive) {
+        return currentTime % window_ == 0;
+    }
+    if (currentTime - lastBatchTime_ >= window_) return true;
+    return policy_.maxDelay > 0 && oldestPending_ >= 0 &&
+           currentTime - oldestPending_ >= policy_.maxDelay;
+}
+
+void BatchController::onBatch(int currentTime, int queueIn, int queueLeft, double costUs) {
+    ++batches_;
+    if (oldestPending_ >= 0) {
+        maxObservedDelay_ = std::max(maxObservedDelay_, currentTime - oldestPending_);
+    }
+
+    lastBatchTime_ = currentTime;
+    oldestPending_ = -1;
+    arrived_  = false;
+    freed_    = false;
+    carried_  = false;
+    queueLen_ = queueLeft;
+
+    if (!policy_.adaptive) return;
+
+    // deep queue and expensive batch: batch less often, more jobs per matching
+    // short queue: batch more often, lower per-job latency
+    if (queueIn >= policy_.queueHigh && costUs >= policy_.costTargetUs) {
+        window_ = std::min(window_ * 2, policy_.maxBatch);
+    } else if (queueIn <= policy_.queueLow) {
+        window_ = std::max(window_ / 2, policy_.minBatch);
+    }
+}
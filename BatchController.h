@@ -0,0 +1,58 @@
+#ifndef BATCH_CONTROLLER_H
+#define BATCH_CONTROLLER_H
+
+struct BatchPolicy {
+    bool adaptive      = false; // false: fixed window = batchSize
+    int  minBatch      = 1;     // adaptive window bounds (ticks)
+    int  maxBatch      = 32;
+    int  maxDelay      = 0;     // max ticks an arrival waits for its first batch, 0 = no bound
+    int  queueHigh     = 64;    // grow window when waiting queue >= queueHigh ...
+    double costTargetUs = 0.0;  // ... and last batch took >= costTargetUs (0 = ignore cost)
+    int  queueLow      = 8;     // shrink window when waiting queue <= queueLow
+};
+
+// BatchController：decides at which ticks Simulation::run calls runBatch
+// - A batch is due when the window has elapsed since the last batch
+//   (fixed mode: currentTime % batchSize == 0), or when the oldest
+//   unscheduled arrival hits maxDelay
+// - A due batch is skipped if nothing arrived and no capacity was freed
+//   for waiting jobs since the last batch (the result could not change),
+//   unless the scheduler carried unfinished work out of the last batch
+// - Adaptive mode doubles/halves the window from queue depth and batch cost
+class BatchController {
+public:
+    BatchController(const BatchPolicy& policy, int batchSize);
+
+    void onArrivals(int count, int currentTime);
+    void onCapacityFreed(int amount);
+    void onCarry() { carried_ = true; } // after onBatch, see Scheduler::hasCarriedWork
+
+    bool due(int currentTime) const;
+    bool dirty() const { return arrived_ || carried_ || (freed_ && queueLen_ > 0); }
+
+    // queueIn: waiting jobs given to runBatch, queueLeft: still waiting afterwards
+    void onBatch(int currentTime, int queueIn, int queueLeft, double costUs);
+    void onSkip() { ++skipped_; }
+
+    int window() const { return window_; }
+    int batches() const { return batches_; }
+    int skipped() const { return skipped_; }
+    int maxObservedDelay() const { return maxObservedDelay_; }
+
+private:
+    BatchPolicy policy_;
+    int window_;
+
+    int  lastBatchTime_;
+    int  oldestPending_ = -1; // arrival time of first job since last batch, -1 = none
+    bool arrived_ = false;
+    bool freed_   = false;
+    bool carried_ = false;
+    int  queueLen_ = 0; // jobs left waiting by the last batch
+
+    int batches_ = 0;
+    int skipped_ = 0;
+    int maxObservedDelay_ = 0;
+};
+
+#endif // BATCH_CONTROLLER_H
@@ -0,0 +1,340 @@
+#include "BatchSolver.h"
+#include "DAScheduler.h"
+#include "Arena.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// read-only view of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return ok_; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool ok_ = false;
+#ifdef _WIN32
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+
+    void open(const std::string& path) {
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file_, &sz)) return;
+        size_ = static_cast<std::size_t>(sz.QuadPart);
+        ok_ = true;
+        if (size_ == 0) return; // empty files can't be mapped
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_) data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        ok_ = (data_ != nullptr);
+    }
+
+    void close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+    }
+#else
+    void open(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            size_ = static_cast<std::size_t>(st.st_size);
+            ok_ = true;
+            if (size_ > 0) {
+                void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    ok_ = false;
+                } else {
+                    madvise(p, size_, MADV_SEQUENTIAL);
+                    data_ = static_cast<const char*>(p);
+                }
+            }
+        }
+        ::close(fd); // the mapping keeps the file alive
+    }
+
+    void close() {
+        if (data_) munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+};
+
+// whitespace separated integers over a byte range
+class IntScanner {
+public:
+    IntScanner(const char* begin, const char* end) : begin_(begin), p_(begin), end_(end) {}
+
+    // true once only whitespace is left
+    bool atEnd() {
+        skipSpace();
+        return p_ == end_;
+    }
+
+    bool next(long long& v) {
+        skipSpace();
+        bool neg = false;
+        if (p_ != end_ && (*p_ == '-' || *p_ == '+')) {
+            neg = (*p_ == '-');
+            ++p_;
+        }
+        if (p_ == end_ || *p_ < '0' || *p_ > '9') return false;
+        unsigned long long x = 0;
+        while (p_ != end_ && *p_ >= '0' && *p_ <= '9') {
+            if (x > (std::numeric_limits<unsigned long long>::max() - 9) / 10) return false;
+            x = x * 10 + static_cast<unsigned>(*p_ - '0');
+            ++p_;
+        }
+        if (x > static_cast<unsigned long long>(std::numeric_limits<long long>::max())) return false;
+        v = neg ? -static_cast<long long>(x) : static_cast<long long>(x);
+        return true;
+    }
+
+    bool next(int& v) {
+        long long x;
+        if (!next(x) || x < std::numeric_limits<int>::min() || x > std::numeric_limits<int>::max()) {
+            return false;
+        }
+        v = static_cast<int>(x);
+        return true;
+    }
+
+    std::size_t offset() const { return static_cast<std::size_t>(p_ - begin_); }
+
+private:
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+
+    void skipSpace() {
+        while (p_ != end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+    }
+};
+
+bool parseOne(IntScanner& in, MatchingInstance& inst) {
+    int n, m;
+    if (!in.next(n) || !in.next(m) || n < 0 || m < 0) return false;
+
+    inst.capacity.resize(n);
+    for (int s = 0; s < n; ++s) {
+        if (!in.next(inst.capacity[s])) return false;
+    }
+
+    inst.demand.resize(m);
+    inst.prefs.resize(m);
+    inst.scores.resize(m);
+    for (int j = 0; j < m; ++j) {
+        int L;
+        if (!in.next(inst.demand[j]) || !in.next(L) || L < 0) return false;
+        inst.prefs[j].resize(L);
+        inst.scores[j].resize(L);
+        for (int k = 0; k < L; ++k) {
+            int s;
+            if (!in.next(s) || !in.next(inst.scores[j][k])) return false;
+            if (s < 1 || s > n) return false;
+            inst.prefs[j][k] = s - 1;
+        }
+    }
+    return true;
+}
+
+// calls body(i) for i in [0, count) on 'threads' workers, dynamic assignment
+void parallelFor(std::size_t count, int threads, const std::function<void(int, std::size_t)>& body) {
+    std::atomic<std::size_t> next(0);
+    auto worker = [&](int t) {
+        if (threads > 1) Trace::setThreadName("solver");
+        for (std::size_t i = next++; i < count; i = next++) body(t, i);
+    };
+    if (threads == 1) {
+        worker(0);
+        return;
+    }
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+    for (auto& th : pool) th.join();
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void appendInt(std::string& buf, int v) {
+    char tmp[12];
+    int len = 0;
+    unsigned int x = (v < 0) ? 0u - static_cast<unsigned int>(v) : static_cast<unsigned int>(v);
+    do {
+        tmp[len++] = static_cast<char>('0' + x % 10);
+        x /= 10;
+    } while (x);
+    if (v < 0) buf.push_back('-');
+    while (len) buf.push_back(tmp[--len]);
+}
+
+void appendU32(std::string& buf, std::uint32_t v) {
+    for (int b = 0; b < 4; ++b) buf.push_back(static_cast<char>((v >> (8 * b)) & 0xFF));
+}
+
+} // namespace
+
+bool parseLegacyInstances(const char* begin, const char* end,
+                          std::vector<MatchingInstance>& out,
+                          std::string& error) {
+    IntScanner in(begin, end);
+    while (!in.atEnd()) {
+        std::size_t start = in.offset();
+        out.emplace_back();
+        if (!parseOne(in, out.back())) {
+            error = "instance " + std::to_string(out.size() - 1) + " (byte " +
+                    std::to_string(start) + "): malformed near byte " +
+                    std::to_string(in.offset());
+            out.pop_back();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool writeMatchings(const std::string& path, const std::string& format,
+                    const std::vector<Matching>& matchings) {
+    bool binary = (format == "binary");
+    std::string buf;
+    if (binary) {
+        buf.append("DAM1");
+        appendU32(buf, static_cast<std::uint32_t>(matchings.size()));
+    }
+    for (const Matching& match : matchings) {
+        if (binary) {
+            appendU32(buf, static_cast<std::uint32_t>(match.size()));
+            for (int s : match) appendU32(buf, static_cast<std::uint32_t>(s + 1));
+        } else {
+            for (int s : match) {
+                appendInt(buf, s + 1);
+                buf.push_back('\n');
+            }
+        }
+    }
+
+    std::FILE* f = std::fopen(path.c_str(), binary ? "wb" : "w");
+    if (!f) return false;
+    bool ok = (std::fwrite(buf.data(), 1, buf.size(), f) == buf.size());
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
+
+int runSolveMode(const SolveConfig& cfg) {
+    using Clock = std::chrono::steady_clock;
+
+    // S1. map + parse
+    Clock::time_point t0 = Clock::now();
+    MappedFile file(cfg.input);
+    if (!file.ok()) {
+        std::cerr << "Cannot map solve input '" << cfg.input << "'\n";
+        return 1;
+    }
+    std::vector<MatchingInstance> instances;
+    std::string error;
+    bool parsed;
+    {
+        TRACE_SCOPE("parse");
+        parsed = parseLegacyInstances(file.begin(), file.end(), instances, error);
+    }
+    if (!parsed) {
+        std::cerr << "Bad solve input '" << cfg.input << "': " << error << "\n";
+        return 1;
+    }
+    double parseSec = secondsSince(t0);
+
+    long long totalJobs = 0;
+    for (const MatchingInstance& inst : instances) totalJobs += inst.numJobs();
+
+    int threads = cfg.threads;
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+    threads = std::min<long long>(threads, std::max<long long>(static_cast<long long>(instances.size()), 1));
+
+    std::cout << "=== Solve: " << instances.size() << " instances (" << totalJobs << " jobs) from "
+              << cfg.input << ", " << threads << " threads ===\n";
+
+    // S2. solve, one scheduler + arena per worker
+    std::vector<Matching> matchings(instances.size());
+    std::vector<Arena> arenas(threads);
+    std::vector<DAScheduler> schedulers(threads);
+    t0 = Clock::now();
+    parallelFor(instances.size(), threads, [&](int t, std::size_t i) {
+        arenas[t].reset();
+        TRACE_SCOPE("solve instance", static_cast<long long>(i));
+        schedulers[t].setPriority(instancePriority(instances[i]));
+        matchings[i] = solveWithScheduler(schedulers[t], instances[i], arenas[t]);
+    });
+    double solveSec = secondsSince(t0);
+
+    // S3. write
+    double writeSec = 0.0;
+    if (!cfg.output.empty()) {
+        t0 = Clock::now();
+        TRACE_SCOPE("write");
+        if (!writeMatchings(cfg.output, cfg.format, matchings)) {
+            std::cerr << "Cannot write solve output '" << cfg.output << "'\n";
+            return 1;
+        }
+        writeSec = secondsSince(t0);
+    }
+
+    double mb = file.size() / (1024.0 * 1024.0);
+    std::cout << "Parse: " << parseSec << " s (" << (parseSec > 0 ? mb / parseSec : 0.0) << " MB/s)\n";
+    std::cout << "Solve: " << solveSec << " s ("
+              << (solveSec > 0 ? instances.size() / solveSec : 0.0) << " instances/s, "
+              << (solveSec > 0 ? totalJobs / solveSec : 0.0) << " jobs/s)\n";
+    if (!cfg.output.empty()) {
+        std::cout << "Write: " << writeSec << " s -> " << cfg.output << " (" << cfg.format << ")\n";
+    }
+
+    // S4. optional cross-check against the legacy reference
+    if (!cfg.check) return 0;
+    std::atomic<int> mismatches(0);
+    std::atomic<std::size_t> firstBad(instances.size());
+    t0 = Clock::now();
+    parallelFor(instances.size(), threads, [&](int, std::size_t i) {
+        if (solveLegacyDA(instances[i]) == matchings[i]) return;
+        ++mismatches;
+        std::size_t cur = firstBad.load();
+        while (i < cur && !firstBad.compare_exchange_weak(cur, i)) {}
+    });
+    std::cout << "Check: " << secondsSince(t0) << " s, " << mismatches.load()
+              << " of " << instances.size() << " instances differ from legacy";
+    if (mismatches.load() > 0) std::cout << " (first: instance " << firstBad.load() << ")";
+    std::cout << "\n";
+    return mismatches.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include <string>
+#include <vector>
+
+#include "MatchingInstance.h"
+
+struct SolveConfig {
+    std::string input;                             // legacy instances, concatenated
+    std::string output = "results/solve_out.txt";  // "" = don't write
+    std::string format = "text";                   // "text" or "binary"
+    int threads = 0;                               // 0 = hardware_concurrency
+    bool check  = false;                           // also run the legacy reference and compare
+};
+
+// Parses legacy instances (see MatchingInstance.h) straight from a byte
+// range, no iostream: whitespace separated integers, instances back to back.
+// Returns false on malformed input; 'error' then says where.
+bool parseLegacyInstances(const char* begin, const char* end,
+                          std::vector<MatchingInstance>& out,
+                          std::string& error);
+
+// Matchings in the legacy output convention (1-based server id, 0 = unmatched):
+//   text:   per instance, one line per job, like final_project.cpp
+//   binary: "DAM1", u32 instances, then per instance u32 jobs + one i32 per
+//           job, all little endian
+bool writeMatchings(const std::string& path, const std::string& format,
+                    const std::vector<Matching>& matchings);
+
+// batch solver: map 'input', parse, solve every instance with DAScheduler
+// under the instance's scores on 'threads' workers, write the matchings and
+// print parse / solve / write throughput
+int runSolveMode(const SolveConfig& cfg);
+
+#endif // BATCH_SOLVER_H
@@ -0,0 +1,31 @@
+#include "CapacityIndex.h"
+#include "Server.h"
+
+void CapacityIndex::clear() {
+    index_.clear();
+    key_.clear();
+}
+
+void CapacityIndex::build(const std::vector<Server*>& servers) {
+    clear();
+    key_.assign(servers.size(), 0);
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        if (servers[si]) set(static_cast<int>(si), servers[si]->freeCapacity());
+    }
+}
+
+void CapacityIndex::set(int si, int key) {
+    if (si >= static_cast<int>(key_.size())) key_.resize(si + 1, 0);
+    if (key_[si] > 0) index_.erase({key_[si], si});
+    key_[si] = key > 0 ? key : 0;
+    if (key_[si] > 0) index_.emplace(key_[si], si);
+}
+
+MemUsage CapacityIndex::usage() const {
+    MemUsage u;
+    u.addVector(key_);
+    // rb-tree nodes, approximate
+    u.allocs += static_cast<long long>(index_.size());
+    u.bytes  += static_cast<long long>(index_.size() * (sizeof(Entry) + 4 * sizeof(void*)));
+    return u;
+}
@@ -0,0 +1,61 @@
+#ifndef CAPACITY_INDEX_H
+#define CAPACITY_INDEX_H
+
+#include "MemStats.h"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+class Server;
+
+// CapacityIndex：servers ordered by (key, server index), key = free capacity
+// unless the caller keys them otherwise
+// - best-fit (smallest key that still holds a demand, lowest index on ties,
+//   same order as BaseScheduler) is one lower_bound instead of a server scan
+// - a placement re-keys only the server it went to: O(log servers)
+// - schedulers placing through it (EDF, DRF, Backfill) ignore preference
+//   lists, like BaseScheduler
+class CapacityIndex {
+public:
+    using Entry = std::pair<int, int>; // (key, server index)
+    using const_iterator = std::set<Entry>::const_iterator;
+
+    void clear();
+
+    // every server with free capacity left, keyed by it
+    void build(const std::vector<Server*>& servers);
+
+    // (re)key server si, key <= 0 takes it out
+    void set(int si, int key);
+
+    bool empty() const { return index_.empty(); }
+    int maxKey() const { return index_.empty() ? 0 : index_.rbegin()->first; }
+
+    // servers with key >= demand, best fit first
+    const_iterator from(int demand) const { return index_.lower_bound({demand, -1}); }
+    const_iterator end() const { return index_.end(); }
+
+    // best-fit server for demand, -1 if none
+    int bestFit(int demand) const {
+        auto it = from(demand);
+        return it == end() ? -1 : it->second;
+    }
+
+    // first server in best-fit order that 'fits' also accepts, -1 if none
+    template <typename Fits>
+    int bestFit(int demand, Fits fits) const {
+        for (auto it = from(demand); it != end(); ++it) {
+            if (fits(it->second)) return it->second;
+        }
+        return -1;
+    }
+
+    MemUsage usage() const;
+
+private:
+    std::set<Entry> index_;
+    std::vector<int> key_; // per server index, 0 = not indexed
+};
+
+#endif // CAPACITY_INDEX_H
@@ -1,4 +1,5 @@
 #include "Config.h"
+#include "Distributions.h"
 
 #include <fstream>
 #include <sstream>
@@ -59,8 +60,11 @@ bool loadConfigFromFile(const std::string& path, RunConfig& cfg) {
             }
         };
 
+        if (key == "mode") {
+            cfg.mode = value;
+        }
         // GeneratorConfig
-        if (key == "numJobs") {
+        else if (key == "numJobs") {
             cfg.gen.numJobs = toInt(value, cfg.gen.numJobs);
         } else if (key == "numServers") {
             cfg.gen.numServers = toInt(value, cfg.gen.numServers);
@@ -78,6 +82,43 @@ bool loadConfigFromFile(const std::string& path, RunConfig& cfg) {
             cfg.gen.durationMax = toInt(value, cfg.gen.durationMax);
         } else if (key == "maxArrivalTime") {
             cfg.gen.maxArrivalTime = toInt(value, cfg.gen.maxArrivalTime);
+        } else if (key == "demandDist" || key == "durationDist") {
+            DistSpec spec;
+            if (!parseDistSpec(value, spec)) {
+                std::cerr << "Bad " << key << " '" << value << "', using uniform.\n";
+            }
+            (key == "demandDist" ? cfg.gen.demandDist : cfg.gen.durationDist) = value;
+        } else if (key == "arrivalProcess") {
+            if (value != "uniform" && value != "poisson" && value != "mmpp") {
+                std::cerr << "Unknown arrivalProcess '" << value << "', using uniform.\n";
+            }
+            cfg.gen.arrivalProcess = value;
+        } else if (key == "burstRateFactor") {
+            cfg.gen.burstRateFactor = toDouble(value, cfg.gen.burstRateFactor);
+        } else if (key == "burstFraction") {
+            cfg.gen.burstFraction = toDouble(value, cfg.gen.burstFraction);
+        } else if (key == "burstLength") {
+            cfg.gen.burstLength = toDouble(value, cfg.gen.burstLength);
+        } else if (key == "prefSkew") {
+            cfg.gen.prefSkew = toDouble(value, cfg.gen.prefSkew);
+        } else if (key == "workflowSize") {
+            cfg.gen.workflowSize = std::max(toInt(value, cfg.gen.workflowSize), 0);
+        } else if (key == "workflowEdgeProb") {
+            cfg.gen.workflowEdgeProb = std::min(std::max(toDouble(value, cfg.gen.workflowEdgeProb), 0.0), 1.0);
+        } else if (key == "serversPerRack") {
+            cfg.gen.serversPerRack = std::max(toInt(value, cfg.gen.serversPerRack), 0);
+        } else if (key == "racksPerPod") {
+            cfg.gen.racksPerPod = std::max(toInt(value, cfg.gen.racksPerPod), 0);
+        } else if (key == "deadlineProb") {
+            cfg.gen.deadlineProb = toDouble(value, cfg.gen.deadlineProb);
+        } else if (key == "deadlineSlackMin") {
+            cfg.gen.deadlineSlackMin = toInt(value, cfg.gen.deadlineSlackMin);
+        } else if (key == "deadlineSlackMax") {
+            cfg.gen.deadlineSlackMax = toInt(value, cfg.gen.deadlineSlackMax);
+        } else if (key == "numTenants") {
+            cfg.gen.numTenants = std::max(toInt(value, cfg.gen.numTenants), 1);
+        } else if (key == "tenantSkew") {
+            cfg.gen.tenantSkew = toDouble(value, cfg.gen.tenantSkew);
         } else if (key == "misreportProb") {
             cfg.gen.misreportProb = toDouble(value, cfg.gen.misreportProb);
         } else if (key == "misreportAlpha") {
@@ -96,6 +137,138 @@ bool loadConfigFromFile(const std::string& path, RunConfig& cfg) {
         } else if (key == "numSeeds") {
             cfg.numSeeds = toInt(value, cfg.numSeeds);
             if (cfg.numSeeds <= 0) cfg.numSeeds = 1;
+        } else if (key == "schedulers") {
+            // comma separated, e.g. "base,da,opt"
+            std::vector<std::string> names;
+            std::stringstream ss(value);
+            std::string name;
+            while (std::getline(ss, name, ',')) {
+                name = trim(name);
+                if (!name.empty()) names.push_back(name);
+            }
+            if (!names.empty()) cfg.schedulers = names;
+        } else if (key == "stopMetrics") {
+            // comma separated, e.g. "da_strat-base_strat:avgCompletion,util"
+            std::vector<std::string> specs;
+            std::stringstream ss(value);
+            std::string spec;
+            while (std::getline(ss, spec, ',')) {
+                spec = trim(spec);
+                if (!spec.empty()) specs.push_back(spec);
+            }
+            cfg.stopMetrics = specs;
+        } else if (key == "stopCiAbs") {
+            cfg.stopCiAbs = toDouble(value, cfg.stopCiAbs);
+        } else if (key == "stopCiRel") {
+            cfg.stopCiRel = toDouble(value, cfg.stopCiRel);
+        } else if (key == "minSeeds") {
+            cfg.minSeeds = toInt(value, cfg.minSeeds);
+            if (cfg.minSeeds < 2) cfg.minSeeds = 2;
+        } else if (key == "perSeedRows") {
+            cfg.perSeedRows = (toInt(value, cfg.perSeedRows ? 1 : 0) != 0);
+        } else if (key == "pairedBaseline") {
+            cfg.pairedBaseline = value;
+        }
+        // Batching
+        else if (key == "adaptiveBatch") {
+            cfg.batch.adaptive = (toInt(value, cfg.batch.adaptive ? 1 : 0) != 0);
+        } else if (key == "batchSizeMin") {
+            cfg.batch.minBatch = toInt(value, cfg.batch.minBatch);
+        } else if (key == "batchSizeMax") {
+            cfg.batch.maxBatch = toInt(value, cfg.batch.maxBatch);
+        } else if (key == "maxSchedulingDelay") {
+            cfg.batch.maxDelay = toInt(value, cfg.batch.maxDelay);
+        } else if (key == "batchQueueHigh") {
+            cfg.batch.queueHigh = toInt(value, cfg.batch.queueHigh);
+        } else if (key == "batchQueueLow") {
+            cfg.batch.queueLow = toInt(value, cfg.batch.queueLow);
+        } else if (key == "batchCostTargetUs") {
+            cfg.batch.costTargetUs = toDouble(value, cfg.batch.costTargetUs);
+        } else if (key == "daBudgetRounds") {
+            cfg.daBudget.maxRounds = toInt(value, cfg.daBudget.maxRounds);
+        } else if (key == "daBudgetUs") {
+            cfg.daBudget.maxUs = toDouble(value, cfg.daBudget.maxUs);
+        } else if (key == "daBudgetShadow") {
+            cfg.daBudget.shadow = (toInt(value, cfg.daBudget.shadow ? 1 : 0) != 0);
+        } else if (key == "daScoreFile") {
+            cfg.daScoreFile = value;
+        }
+        // Daemon mode
+        else if (key == "daemonScheduler") {
+            cfg.daemon.scheduler = value;
+        } else if (key == "daemonInput") {
+            cfg.daemon.input = value;
+        } else if (key == "daemonProducers") {
+            cfg.daemon.producers = toInt(value, cfg.daemon.producers);
+        } else if (key == "daemonRatePerSec") {
+            cfg.daemon.ratePerSec = toDouble(value, cfg.daemon.ratePerSec);
+        } else if (key == "daemonDurationMs") {
+            cfg.daemon.durationMs = toInt(value, cfg.daemon.durationMs);
+        } else if (key == "daemonTickUs") {
+            cfg.daemon.tickUs = toInt(value, cfg.daemon.tickUs);
+        }
+        // Verify mode
+        else if (key == "verifyInstances") {
+            cfg.verify.instances = toInt(value, cfg.verify.instances);
+        } else if (key == "verifyMaxJobs") {
+            cfg.verify.maxJobs = toInt(value, cfg.verify.maxJobs);
+        } else if (key == "verifyMaxServers") {
+            cfg.verify.maxServers = toInt(value, cfg.verify.maxServers);
+        } else if (key == "verifyThreads") {
+            cfg.verify.threads = toInt(value, cfg.verify.threads);
+        } else if (key == "verifyShrink") {
+            cfg.verify.shrink = (toInt(value, cfg.verify.shrink ? 1 : 0) != 0);
+        } else if (key == "verifyReproPath") {
+            cfg.verify.reproPath = value;
+        }
+        // Solve mode
+        else if (key == "solveInput") {
+            cfg.solve.input = value;
+        } else if (key == "solveOutput") {
+            cfg.solve.output = value;
+        } else if (key == "solveFormat") {
+            cfg.solve.format = value;
+        } else if (key == "solveThreads") {
+            cfg.solve.threads = toInt(value, cfg.solve.threads);
+        } else if (key == "solveCheck") {
+            cfg.solve.check = (toInt(value, cfg.solve.check ? 1 : 0) != 0);
+        }
+        // Lockstep mode
+        else if (key == "lockstepLanes") {
+            cfg.lockstep.lanes = std::max(toInt(value, cfg.lockstep.lanes), 1);
+        } else if (key == "lockstepCheck") {
+            cfg.lockstep.check = (toInt(value, cfg.lockstep.check ? 1 : 0) != 0);
+        }
+        // Timeline export
+        else if (key == "exportOccupancy") {
+            cfg.exportOccupancy = (toInt(value, cfg.exportOccupancy ? 1 : 0) != 0);
+        } else if (key == "jobRecordSampleEvery") {
+            cfg.jobRecordSampleEvery = toInt(value, cfg.jobRecordSampleEvery);
+            if (cfg.jobRecordSampleEvery < 0) cfg.jobRecordSampleEvery = 0;
+        }
+        else if (key == "memStats") {
+            cfg.memStats = (toInt(value, cfg.memStats ? 1 : 0) != 0);
+        }
+        else if (key == "trace") {
+            cfg.trace = (toInt(value, cfg.trace ? 1 : 0) != 0);
+        } else if (key == "tracePath") {
+            cfg.tracePath = value;
+        } else if (key == "traceMaxEvents") {
+            cfg.traceMaxEvents = std::max(toInt(value, cfg.traceMaxEvents), 0);
+        }
+        // Counterfactual replay
+        else if (key == "counterfactual") {
+            cfg.counterfactual = (toInt(value, cfg.counterfactual ? 1 : 0) != 0);
+        } else if (key == "cfFactors") {
+            // comma separated, e.g. "-0.5,0.5"
+            std::vector<double> factors;
+            std::stringstream ss(value);
+            std::string f;
+            while (std::getline(ss, f, ',')) {
+                f = trim(f);
+                if (!f.empty()) factors.push_back(toDouble(f, 0.0));
+            }
+            if (!factors.empty()) cfg.cfFactors = factors;
         }
     }
 
@@ -2,14 +2,63 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include <memory>
 #include <string>
+#include <vector>
 #include "DataGenerator.h"  
+#include "BatchController.h"
+#include "Daemon.h"
+#include "Verifier.h"
+#include "BatchSolver.h"
+#include "DAScheduler.h"
+#include "Replicated.h"
 
 struct RunConfig {
+    std::string mode = "sweep"; // "sweep" (offline seeds), "daemon" (online), "verify", "solve" or "lockstep"
+
     GeneratorConfig gen;  
     int timeLimit  = 150; 
     int batchSize  = 4;   
-    int numSeeds   = 1; 
+    int numSeeds   = 1;   // seed budget when early stopping is on
+
+    // sequential early stopping: stop adding seeds once the 95% CI half-width of
+    // every selected metric is below stopCiAbs or stopCiRel * |mean|
+    std::vector<std::string> stopMetrics; // "metric" or "type:metric", empty = off
+    double stopCiAbs = 0.0;
+    double stopCiRel = 0.0;
+    int    minSeeds  = 5;
+
+    // schedulers compared on every seed, each runs truthful + strategic
+    std::vector<std::string> schedulers = {"base", "da"};
+
+    // cross-seed summary, see Stats.h
+    bool perSeedRows = true;              // also write one CSV row per (seed, scenario)
+    std::string pairedBaseline = "base";  // others are diffed against it per seed, "" = off
+
+    BatchPolicy batch;    // adaptive batching, off by default
+    DABudget daBudget;    // per-batch limit for schedulers=dabudget (and daemonScheduler)
+    std::string daScoreFile;                    // serverId,jobId,score CSV for schedulers=dascore
+    std::shared_ptr<const PriorityRule> daScores; // loaded from daScoreFile by main
+
+    DaemonConfig   daemon;   // used when mode=daemon
+    VerifyConfig   verify;   // used when mode=verify
+    SolveConfig    solve;    // used when mode=solve
+    LockstepConfig lockstep; // used when mode=lockstep
+
+    // timeline export (first seed only)
+    bool exportOccupancy      = false; // per-server occupancy step functions
+    int  jobRecordSampleEvery = 0;     // also dump 1 of every n job records, 0 = none
+
+    bool memStats = false; // per-phase memory accounting, see MemStats.h
+
+    // wall-clock spans as Chrome trace JSON, see Trace.h
+    bool trace = false;
+    std::string tracePath = "results/trace.json";
+    int traceMaxEvents = 1000000; // per thread
+
+    // per-job misreport gain on the truthful runs, see Counterfactual.h
+    bool counterfactual = false;
+    std::vector<double> cfFactors = {-0.5, 0.5}; // reported = true * (1 + factor)
 };
 
 bool loadConfigFromFile(const std::string& path, RunConfig& cfg);
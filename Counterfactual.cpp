@@ -0,0 +1,219 @@
+#include "Counterfactual.h"
+#include "Job.h"
+#include "Server.h"
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+CounterfactualAnalyzer::CounterfactualAnalyzer(const Simulation& sim,
+                                               const std::vector<Job*>& jobs,
+                                               const std::vector<Server*>& servers)
+    : jobs_(jobs),
+      servers_(servers),
+      trace_(sim.replayTrace()),
+      timeLimit_(sim.timeLimit())
+{
+    arrivalsAt_.assign(timeLimit_ + 1, {});
+    for (std::size_t p = 0; p < jobs_.size(); ++p) {
+        int a = jobs_[p]->arrivalTime();
+        if (a >= 0 && a <= timeLimit_) arrivalsAt_[a].push_back(static_cast<int>(p));
+    }
+
+    int maxId = 0;
+    for (Server* s : servers_) maxId = std::max(maxId, s->id());
+    serverIndexById_.assign(maxId + 1, -1);
+    for (std::size_t si = 0; si < servers_.size(); ++si) {
+        serverIndexById_[servers_[si]->id()] = static_cast<int>(si);
+    }
+
+    copyOf_.assign(jobs_.size(), nullptr);
+}
+
+JobOutcome CounterfactualAnalyzer::baselineOutcome(int pos) const {
+    const Job* j = jobs_[pos];
+    JobOutcome o;
+    if (j->isFinished()) {
+        o.finished   = true;
+        o.startTime  = j->startTime();
+        o.finishTime = j->finishTime();
+    } else if (j->isRunning()) {
+        o.startTime = j->startTime();
+    }
+    return o;
+}
+
+int CounterfactualAnalyzer::firstBatch(int pos) const {
+    const auto& times = trace_.batchTimes;
+    auto it = std::lower_bound(times.begin(), times.end(), jobs_[pos]->arrivalTime());
+    if (it == times.end()) return -1;
+    return static_cast<int>(it - times.begin());
+}
+
+// state after arrivals + finishing at T0, before the batch
+void CounterfactualAnalyzer::buildSnapshot(int batchIdx) {
+    if (snapIdx_ == batchIdx) return;
+    snapIdx_ = batchIdx;
+    int T0 = trace_.batchTimes[batchIdx];
+
+    snapWaiting_.clear();
+    snapRunning_.clear();
+    for (std::size_t p = 0; p < jobs_.size(); ++p) {
+        const Job* j = jobs_[p];
+        if (j->arrivalTime() > T0) continue;
+        if (j->isFailed() && j->finishTime() < T0) continue;
+
+        int s = j->startTime();
+        if (s >= 0 && s < T0) {
+            if (j->isFinished() && j->finishTime() <= T0) continue;
+            int sid = trace_.serverIdByJob[j->id()];
+            snapRunning_.emplace_back(static_cast<int>(p), serverIndexById_[sid]);
+        } else {
+            snapWaiting_.push_back(static_cast<int>(p));
+        }
+    }
+
+    // baseline queue order: by arrival tick, then position
+    std::stable_sort(snapWaiting_.begin(), snapWaiting_.end(),
+                     [this](int a, int b) {
+                         return jobs_[a]->arrivalTime() < jobs_[b]->arrivalTime();
+                     });
+}
+
+Job* CounterfactualAnalyzer::copyJob(int pos, int reported) {
+    const Job* src = jobs_[pos];
+    Job* j = arena_.create<Job>(src->id(),
+                                src->trueDemand(),
+                                reported,
+                                src->duration(),
+                                src->arrivalTime(),
+                                src->preferences(),
+                                src->numPreferences());
+    j->setDeadline(src->deadline());
+    j->setTenant(src->tenant());
+    j->setDependencies(src->workflow(), src->numParents(), src->children(), src->numChildren());
+    copyOf_[pos] = j;
+    touched_.push_back(pos);
+    return j;
+}
+
+JobOutcome CounterfactualAnalyzer::replay(Scheduler& scheduler, int pos, int newReport) {
+    int b = firstBatch(pos);
+    if (b < 0) return baselineOutcome(pos); // never reached a batch
+    buildSnapshot(b);
+    int T0 = trace_.batchTimes[b];
+
+    // S1. fork: fresh servers, copies of the jobs alive at T0
+    arena_.reset();
+    servers2_.clear();
+    for (Server* s : servers_) {
+        servers2_.push_back(arena_.create<Server>(s->id(), s->capacity(), &arena_));
+        servers2_.back()->setLocation(s->rack(), s->pod());
+    }
+    for (const auto& r : snapRunning_) {
+        Job* j = copyJob(r.first, jobs_[r.first]->reportedDemand());
+        j->markRunning(jobs_[r.first]->startTime());
+        servers2_[r.second]->accept(j);
+    }
+    waiting_.clear();
+    for (int p : snapWaiting_) {
+        int rep = (p == pos) ? newReport : jobs_[p]->reportedDemand();
+        waiting_.push_back(copyJob(p, rep));
+    }
+    Job* target = copyOf_[pos];
+    BatchController batcher = trace_.batchers[b];
+
+    // S2. same tick loop as Simulation::run, until the job is decided
+    for (int t = T0; t <= timeLimit_; ++t) {
+        ++ticksReplayed_;
+        if (t > T0) {
+            int arrived = 0;
+            for (int p : arrivalsAt_[t]) {
+                waiting_.push_back(copyJob(p, jobs_[p]->reportedDemand()));
+                ++arrived;
+            }
+            batcher.onArrivals(arrived, t);
+
+            int freed = 0;
+            for (Server* s : servers2_) freed += s->removeFinishedJobs(t, nullptr);
+            batcher.onCapacityFreed(freed);
+        }
+
+        if (batcher.due(t)) {
+            if (batcher.dirty()) {
+                int queueIn = static_cast<int>(waiting_.size());
+                scheduler.runBatch(waiting_, servers2_, t, nullptr);
+                waiting_.erase(std::remove_if(waiting_.begin(), waiting_.end(),
+                                              [](Job* j) { return !j->isWaiting(); }),
+                               waiting_.end());
+                batcher.onBatch(t, queueIn, static_cast<int>(waiting_.size()), 0.0);
+                if (scheduler.hasCarriedWork()) batcher.onCarry();
+            } else {
+                batcher.onSkip();
+            }
+        }
+
+        if (!target->isWaiting()) break;
+    }
+
+    // S3. once placed, the finish tick is fixed by the duration
+    JobOutcome o;
+    if (target->isRunning()) {
+        o.startTime = target->startTime();
+        int finish = o.startTime + std::max(target->duration(), 1);
+        if (finish <= timeLimit_) {
+            o.finished   = true;
+            o.finishTime = finish;
+        }
+    }
+
+    for (int p : touched_) copyOf_[p] = nullptr;
+    touched_.clear();
+    return o;
+}
+
+int CounterfactualAnalyzer::completionTime(const JobOutcome& o, int arrival) const {
+    if (o.finished) return o.finishTime - arrival;
+    return timeLimit_ + 1 - arrival;
+}
+
+DeviationSummary CounterfactualAnalyzer::analyze(Scheduler& scheduler, double factor,
+                                                 int demandMin, int demandMax) {
+    DeviationSummary sum;
+    sum.factor = factor;
+    ticksReplayed_ = 0;
+    if (!scheduler.replayable()) return sum;
+
+    // group by fork point so each snapshot is built once
+    std::vector<std::pair<int, int>> order; // first batch, position
+    for (std::size_t p = 0; p < jobs_.size(); ++p) {
+        int b = firstBatch(static_cast<int>(p));
+        if (b >= 0) order.emplace_back(b, static_cast<int>(p));
+    }
+    std::sort(order.begin(), order.end());
+
+    double gainSum = 0.0;
+    for (const auto& e : order) {
+        int pos = e.second;
+        const Job* j = jobs_[pos];
+
+        int report = static_cast<int>(std::round(j->trueDemand() * (1.0 + factor)));
+        report = std::min(std::max(report, demandMin), demandMax);
+        if (report == j->reportedDemand()) continue;
+
+        JobOutcome base = baselineOutcome(pos);
+        JobOutcome dev  = replay(scheduler, pos, report);
+
+        double gain = completionTime(base, j->arrivalTime()) - completionTime(dev, j->arrivalTime());
+        ++sum.jobs;
+        if (gain > 0) ++sum.improved;
+        if (gain < 0) ++sum.worsened;
+        gainSum += gain;
+        sum.maxGain = std::max(sum.maxGain, gain);
+    }
+
+    if (sum.jobs > 0) sum.avgGain = gainSum / sum.jobs;
+    sum.ticksReplayed = ticksReplayed_;
+    sum.ticksFull     = static_cast<long long>(sum.jobs) * (timeLimit_ + 1);
+    return sum;
+}
@@ -0,0 +1,87 @@
+#ifndef COUNTERFACTUAL_H
+#define COUNTERFACTUAL_H
+
+#include <vector>
+#include <utility>
+
+#include "Simulation.h"
+#include "BatchController.h"
+#include "Arena.h"
+
+class Job;
+class Server;
+class Scheduler;
+
+struct JobOutcome {
+    bool finished   = false;
+    int  startTime  = -1;
+    int  finishTime = -1;
+};
+
+// one deviation factor applied to every job in turn
+struct DeviationSummary {
+    double factor = 0.0;   // reported = round(true * (1 + factor)), clamped
+    int jobs      = 0;     // jobs whose report actually changed
+    int improved  = 0;     // lying shortened the job's completion time
+    int worsened  = 0;
+    double avgGain = 0.0;  // completion time saved by lying (unfinished = censored at timeLimit+1)
+    double maxGain = 0.0;
+    long long ticksReplayed = 0; // ticks simulated by the replays
+    long long ticksFull     = 0; // ticks the same analysis costs with full reruns
+};
+
+// CounterfactualAnalyzer：per-job "what if this job had reported d instead"
+// - Needs a finished baseline run with sim.setReplayTracing(true); the
+//   baseline jobs/servers are only read, never modified
+// - The state before any batch is rebuilt from the baseline trajectory
+//   (start/finish times + placement), so nothing is copied up front
+// - A replay forks at the first batch the job takes part in, copies only
+//   the jobs it touches (waiting, running, later arrivals) into a scratch
+//   Arena, and stops as soon as the job is placed or failed
+// - Replays are exact for fixed batching and for adaptive batching without
+//   a wall-clock cost target, and only for replayable() schedulers;
+//   analyze() returns an empty summary for the others
+class CounterfactualAnalyzer {
+public:
+    CounterfactualAnalyzer(const Simulation& sim,
+                           const std::vector<Job*>& jobs,
+                           const std::vector<Server*>& servers);
+
+    JobOutcome baselineOutcome(int pos) const;
+
+    // outcome of jobs[pos] if it had reported newReport, everything else unchanged
+    JobOutcome replay(Scheduler& scheduler, int pos, int newReport);
+
+    DeviationSummary analyze(Scheduler& scheduler, double factor,
+                             int demandMin, int demandMax);
+
+private:
+    const std::vector<Job*>& jobs_;
+    const std::vector<Server*>& servers_;
+    const ReplayTrace& trace_;
+    int timeLimit_;
+
+    std::vector<std::vector<int>> arrivalsAt_; // tick -> job positions, in jobs order
+    std::vector<int> serverIndexById_;
+
+    // state right before batch snapIdx_, rebuilt when a replay needs another batch
+    int snapIdx_ = -1;
+    std::vector<int> snapWaiting_;                  // positions, baseline queue order
+    std::vector<std::pair<int, int>> snapRunning_;  // position, server index
+
+    // copy-on-write scratch
+    Arena arena_;
+    std::vector<Job*> copyOf_;   // position -> copy in this replay
+    std::vector<int>  touched_;
+    std::vector<Job*> waiting_;
+    std::vector<Server*> servers2_;
+
+    long long ticksReplayed_ = 0;
+
+    int firstBatch(int pos) const;
+    void buildSnapshot(int batchIdx);
+    Job* copyJob(int pos, int reported);
+    int completionTime(const JobOutcome& o, int arrival) const;
+};
+
+#endif // COUNTERFACTUAL_H
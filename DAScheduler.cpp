@@ -2,27 +2,23 @@
 #include "Job.h"
 #include "Server.h"
 #include "Simulation.h"
+#include "Trace.h"
 
 #include <vector>
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <iostream>
+#include <iterator>
 
-static int findServerIndexById(const std::vector<Server*>& servers, int sid) {
-    for (std::size_t i = 0; i < servers.size(); ++i) {
-        if (servers[i] && servers[i]->id() == sid) {
-            return static_cast<int>(i);
-        }
-    }
-    return -1;
-}
-
-static bool isMatched(const std::vector<std::vector<Job*>>& matches, Job* job) {
-    for (const auto& vec : matches) {
-        for (Job* j : vec) {
-            if (j == job) return true;
-        }
+// Server preference: smaller reported demand first, ties by job id
+// (a strict order, so the result doesn't depend on sort internals)
+static bool serverPrefers(const Job* a, const Job* b) {
+    if (a->reportedDemand() != b->reportedDemand()) {
+        return a->reportedDemand() < b->reportedDemand();
     }
-    return false;
+    return a->id() < b->id();
 }
 
 void DAScheduler::runBatch(std::vector<Job*>& jobs,
@@ -30,9 +26,12 @@ void DAScheduler::runBatch(std::vector<Job*>& jobs,
                            int currentTime,
                            Simulation *sim)
 {
+    batchStart_ = std::chrono::steady_clock::now();
+    carried_ = false;
+
     // S1. grab jobs that participated in current DA round
-    std::vector<Job*> active;
-    active.reserve(jobs.size());
+    std::vector<Job*>& active = active_;
+    active.clear();
     for (Job* j : jobs) {
         if (!j) continue;
         if (j->isWaiting()) {
@@ -45,31 +44,217 @@ void DAScheduler::runBatch(std::vector<Job*>& jobs,
     }
 
     // S2. Each server maintains a "newly accepted job list"
-    std::vector<std::vector<Job*>> matches(servers.size());
-    std::vector<std::vector<Job*>> proposals(servers.size());
+    std::vector<std::vector<Job*>>& matches   = matches_;
+    std::vector<std::vector<Job*>>& proposals = proposals_;
+    matches.resize(servers.size());
+    proposals.resize(servers.size());
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        matches[si].clear();
+        proposals[si].clear();
+    }
     
-    // S3. Restore active job's preference iterator
-    for (Job* j : active) {
-        j->resetPreferencesIter();
+    // S3. Restore active job's preference iterator. A complete batch leaves no
+    //     active job waiting, so under a budget only the leftovers of a cut
+    //     batch have moved, and they keep their place
+    if (!budget_.limited()) {
+        for (Job* j : active) {
+            j->resetPreferencesIter();
+        }
     }
 
-    // S4. DA main loop
-    while (true) {
+    // S4. When every server ranks by (reportedDemand, id) there is one common
+    //     priority, and since demand grows along it the greedy fill accepts a
+    //     prefix of the candidates. Then DA ends where serial dictatorship ends,
+    //     so one ordered pass is enough. Other rules (and knapsack acceptance,
+    //     which is not a prefix rule) run the rounds on compiled rank tables
+    int maxId = indexServers(servers);
+    bool demandOrder = priority_->demandOrdered();
+    if (!demandOrder || acceptance_ == Acceptance::Knapsack) {
+        compileRanks(servers, maxId);
+        demandOrder = demandOrder || ranksFollowDemand_; // e.g. a table of -demand scores
+    }
+
+    bool shadow = budget_.shadow && budget_.limited();
+    if (shadow) {
+        markActive(startMarks_);
+        startRemaining_ = remaining_;
+    }
+    int rounds = runEngine(servers, currentTime, maxId, demandOrder);
+    double batchUs = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - batchStart_).count();
+    if (shadow && carried_) measureCut(servers, currentTime, maxId, demandOrder);
+
+    // S5. When DA converges, writeback matches to server and mark corresponding jobs as Running
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        Server* s = servers[si];
+        if (!s) continue;
+
+        auto& curMatches = matches[si];
+        for (Job* job : curMatches) {
+            if (!job) continue;
+            if (job->isWaiting()) {
+                if (s->accept(job)) { 
+                    job->markRunning(currentTime);
+                    if (sim) sim->logJobStart(job, s, currentTime);
+                } else {
+                    job->markFailed(currentTime);
+                }
+            }
+        }
+    }
+
+    // S6. budget bookkeeping
+    ++batches_;
+    rounds_ += rounds;
+    maxRounds_ = std::max(maxRounds_, rounds);
+    maxBatchUs_ = std::max(maxBatchUs_, batchUs);
+    if (budget_.maxUs > 0.0 && batchUs > budget_.maxUs) {
+        ++overruns_;
+        maxOverrunUs_ = std::max(maxOverrunUs_, batchUs - budget_.maxUs);
+    }
+    if (carried_) {
+        ++budgetCuts_;
+        for (Job* j : active) {
+            if (j->isWaiting()) ++cutCarried_;
+            else ++cutDecided_;
+        }
+    }
+}
+
+// returns the rounds run, the serial pass counts as one
+int DAScheduler::runEngine(std::vector<Server*>& servers, int currentTime,
+                           int maxId, bool demandOrder) {
+    if (engine_ == Engine::Rounds || acceptance_ == Acceptance::Knapsack || !demandOrder) {
+        return runRounds(servers, currentTime, maxId, demandOrder);
+    }
+    TRACE_SCOPE("da serial", static_cast<long long>(active_.size()));
+    runSerial(currentTime, maxId);
+    return 1;
+}
+
+void DAScheduler::markActive(std::vector<JobMark>& out) const {
+    out.clear();
+    for (const Job* j : active_) out.push_back({j->state(), j->preferenceIndex(), j->finishTime()});
+}
+
+void DAScheduler::rewindActive(const std::vector<JobMark>& marks) {
+    for (std::size_t a = 0; a < active_.size(); ++a) {
+        active_[a]->rewindDA(marks[a].state, marks[a].prefIndex, marks[a].finishTime);
+    }
+}
+
+// the cut batch's held set against the uncut fixed point from the same start
+// (same iterators, same free capacity); nothing has been committed yet, so
+// rewinding jobs, matches and capacities undoes the what-if pass
+void DAScheduler::measureCut(std::vector<Server*>& servers, int currentTime,
+                             int maxId, bool demandOrder) {
+    TRACE_SCOPE("da shadow");
+    auto count = [this](long long& placed, long long& demand) {
+        for (const auto& m : matches_) {
+            placed += static_cast<long long>(m.size());
+            for (const Job* j : m) demand += j->reportedDemand();
+        }
+    };
+
+    // S1. keep the cut outcome
+    count(cutPlaced_, cutDemand_);
+    markActive(cutMarks_);
+    cutRemaining_ = remaining_;
+    cutMatches_.swap(matches_);
+
+    // S2. same batch without a budget
+    rewindActive(startMarks_);
+    remaining_ = startRemaining_;
+    matches_.resize(servers.size());
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        matches_[si].clear();
+        proposals_[si].clear();
+    }
+    DABudget budget = budget_;
+    budget_ = DABudget();
+    runEngine(servers, currentTime, maxId, demandOrder);
+    budget_ = budget;
+    carried_ = true;
+    count(fullPlaced_, fullDemand_);
+    ++shadowBatches_;
+
+    // S3. back to the cut outcome
+    rewindActive(cutMarks_);
+    remaining_ = cutRemaining_;
+    matches_.swap(cutMatches_);
+}
+
+bool DAScheduler::outOfTime() const {
+    return budget_.maxUs > 0.0 &&
+           std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - batchStart_).count() >= budget_.maxUs;
+}
+
+bool DAScheduler::outOfBudget(int rounds) const {
+    if (budget_.maxRounds > 0 && rounds >= budget_.maxRounds) return true;
+    return outOfTime();
+}
+
+// proposal / rejection rounds until nobody proposes
+// - demandOrder: each server keeps its tentatively accepted jobs in a
+//   DemandPool; new proposals go straight in and only the overflow at the
+//   tail is evicted, so a round costs O(proposals + evictions) per server.
+//   The priority is monotone in demand, so greedy acceptance keeps a prefix
+//   of the pool, i.e. trimming the tail until it fits gives the same set
+// - otherwise the held jobs stay sorted by rank and new proposals are
+//   merged in (rankedRound)
+// - a budget cut ends the loop early, what is held at that point is the
+//   batch's matching; returns the rounds run. The round limit applies between
+//   rounds, the clock also every BUDGET_CHECK_EVERY proposals and before each
+//   server's merge, so a round can be cut part way: proposals not merged yet
+//   are dropped and their jobs retry the same server next batch. At least one
+//   server merges per batch, so every batch makes progress
+int DAScheduler::runRounds(std::vector<Server*>& servers, int currentTime,
+                            int maxId, bool demandOrder) {
+    std::vector<Job*>& active = active_;
+    std::vector<std::vector<Job*>>& proposals = proposals_;
+
+    int maxDemand = 0;
+    int maxJobId = 0;
+    for (Job* job : active) {
+        maxDemand = std::max(maxDemand, job->reportedDemand());
+        maxJobId  = std::max(maxJobId, job->id());
+    }
+    heldById_.assign(maxJobId + 1, 0);
+
+    pools_.resize(servers.size());
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        pools_[si].reset(remaining_[si], maxDemand);
+    }
+
+    const bool timed = budget_.maxUs > 0.0;
+    bool cut = false;
+    int rounds = 0;
+    while (!cut) {
+        if (rounds > 0 && outOfBudget(rounds)) {
+            carried_ = true;
+            break;
+        }
+        TRACE_SCOPE("da round", rounds + 1);
         bool anyProposal = false;
 
         // 4.1 Let every "not matched and still have nextpreference" jobs propose
+        int seen = 0;
         for (Job* job : active) {
-            if (!job) continue;
-            if (!job->isWaiting()) continue; 
-            if (isMatched(matches, job)) continue; 
+            if (timed && anyProposal && ++seen % BUDGET_CHECK_EVERY == 0 && outOfTime()) {
+                cut = true; // merge what was proposed so far
+                break;
+            }
+            if (!job->isWaiting()) continue;
+            if (job->id() >= 0 && heldById_[job->id()]) continue;
 
             int sid = job->nextPreferredServer();
             if (sid < 0) {
                 job->markFailed(currentTime);
-                continue; 
+                continue;
             }
 
-            int sIdx = findServerIndexById(servers, sid);
+            int sIdx = (sid <= maxId) ? serverIndexById_[sid] : -1;
             if (sIdx < 0) {
                 job->advancePreference();
                 continue;
@@ -82,91 +267,446 @@ void DAScheduler::runBatch(std::vector<Job*>& jobs,
         if (!anyProposal) {
             break;
         }
+        ++rounds;
 
-        // 4.2 Each server handles this round's propose
+        // 4.2 Each server merges this round's proposals, then rejects what doesn't fit
+        bool merged = false;
         for (std::size_t si = 0; si < servers.size(); ++si) {
-            Server* s = servers[si];
-            if (!s) continue;
-
-            auto& curMatches = matches[si];
-            auto& newProps   = proposals[si];
-
-            if (newProps.empty()) {
+            auto& newProps = proposals[si];
+            if (newProps.empty()) continue;
+            if (timed && merged && (cut || outOfTime())) {
+                cut = true;
+                newProps.clear(); // not held, the iterator still points here
                 continue;
             }
+            merged = true;
 
-            // Candidates = matched + newly proposed
-            std::vector<Job*> candidates;
-            candidates.reserve(curMatches.size() + newProps.size());
-            candidates.insert(candidates.end(), curMatches.begin(), curMatches.end());
-            candidates.insert(candidates.end(), newProps.begin(), newProps.end());
-
-            std::sort(candidates.begin(), candidates.end());
-            candidates.erase(std::unique(candidates.begin(), candidates.end()),
-                             candidates.end());
-
-            // Server preference
-            std::sort(candidates.begin(), candidates.end(),
-                      [](Job* a, Job* b) {
-                          return a->reportedDemand() < b->reportedDemand();
-                      });
-
-            // Choose subset
-            std::vector<Job*> newMatches;
-            newMatches.reserve(candidates.size());
-
-            int remainingCap = s->freeCapacity(); 
-
-            for (Job* job : candidates) {
-                int d = job->reportedDemand(); 
-                if (d <= remainingCap) {
-                    newMatches.push_back(job);
-                    remainingCap -= d;
+            int cap = remaining_[si];
+            if (acceptance_ == Acceptance::Knapsack) {
+                // rows: held + proposed bounds the candidates
+                std::size_t rows = matches_[si].size() + newProps.size() + 1;
+                std::size_t words = static_cast<std::size_t>(cap) / 64 + 1;
+                if (cap > KNAPSACK_MAX_CAPACITY) {
+                    ++greedyFallbacks_;
+                } else if (rows * words > KNAPSACK_MAX_TABLE_WORDS) {
+                    ++tableFallbacks_;
+                } else {
+                    knapsackRound(si, cap, newProps);
+                    continue;
                 }
             }
-            
-            // As per server, current DA result is 'newMatches'
-            // Jobs removed in previous curMatches is regarded as rejected, try next preference
-            // Jobs not selected by proposal also needs to try next preference
-
-            // record previous matches
-            std::vector<Job*> oldMatches = curMatches;
-            curMatches = newMatches;
-
-            // jobs removed from old matches
-            for (Job* job : oldMatches) {
-                if (std::find(curMatches.begin(), curMatches.end(), job) == curMatches.end()) {
-                    job->advancePreference();
-                }
+            if (demandOrder) {
+                poolRound(si, newProps);
+            } else {
+                rankedRound(si, cap, newProps);
             }
+        }
+    }
 
-            // Jobs not selected by proposal
-            for (Job* job : newProps) {
-                if (std::find(curMatches.begin(), curMatches.end(), job) == curMatches.end()) {
-                    job->advancePreference();
-                }
+    if (cut) carried_ = true;
+
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        pools_[si].drain(matches_[si]); // other servers keep theirs in matches_ already
+    }
+    return rounds;
+}
+
+void DAScheduler::poolRound(std::size_t si, std::vector<Job*>& newProps) {
+    DemandPool& pool = pools_[si];
+    for (Job* job : newProps) {
+        if (job->reportedDemand() > pool.capacity) {
+            job->advancePreference(); // can never fit here
+            continue;
+        }
+        pool.insert(job);
+        if (job->id() >= 0) heldById_[job->id()] = 1;
+    }
+    while (pool.used > pool.capacity) {
+        Job* out = pool.evictLast();
+        if (out->id() >= 0) heldById_[out->id()] = 0;
+        out->advancePreference();
+    }
+    newProps.clear();
+}
+
+// greedy fill in rank order over held + proposed, skipping what doesn't fit
+void DAScheduler::rankedRound(std::size_t si, int cap, std::vector<Job*>& newProps) {
+    auto byRank = [this](const Job* a, const Job* b) { return rankOf(a) < rankOf(b); };
+
+    std::vector<Job*>& held = matches_[si];
+    std::vector<Job*>& fresh = order_;
+    fresh.clear();
+    for (Job* job : newProps) {
+        if (job->reportedDemand() > cap) {
+            job->advancePreference(); // can never fit here
+            continue;
+        }
+        fresh.push_back(job);
+    }
+    std::sort(fresh.begin(), fresh.end(), byRank);
+
+    std::vector<Job*>& merged = merged_;
+    merged.clear();
+    std::merge(held.begin(), held.end(), fresh.begin(), fresh.end(),
+               std::back_inserter(merged), byRank);
+
+    held.clear();
+    int left = cap;
+    for (Job* job : merged) {
+        int d = job->reportedDemand();
+        if (d <= left) {
+            held.push_back(job);
+            left -= d;
+            if (job->id() >= 0) heldById_[job->id()] = 1;
+        } else {
+            if (job->id() >= 0) heldById_[job->id()] = 0;
+            job->advancePreference();
+        }
+    }
+    newProps.clear();
+}
+
+int DAScheduler::rankOf(const Job* job) const {
+    return rankAt_[prefOffset_[activeIndexById_[job->id()]] + job->preferenceIndex()];
+}
+
+// rank tables: for every (active job, preference slot) the job's rank at that
+// server among all jobs listing it, 0 = best; -1 for servers not in the batch
+void DAScheduler::compileRanks(const std::vector<Server*>& servers, int maxId) {
+    int maxJobId = 0;
+    for (Job* job : active_) maxJobId = std::max(maxJobId, job->id());
+    activeIndexById_.assign(maxJobId + 1, -1);
+
+    prefOffset_.assign(active_.size() + 1, 0);
+    for (std::size_t a = 0; a < active_.size(); ++a) {
+        if (active_[a]->id() >= 0) activeIndexById_[active_[a]->id()] = static_cast<int>(a);
+        prefOffset_[a + 1] = prefOffset_[a] + active_[a]->numPreferences();
+    }
+    rankAt_.assign(prefOffset_.back(), -1);
+    scoreAt_.assign(prefOffset_.back(), 0);
+
+    rankEntries_.resize(servers.size());
+    for (auto& e : rankEntries_) e.clear();
+    for (std::size_t a = 0; a < active_.size(); ++a) {
+        const Job* job = active_[a];
+        const int* prefs = job->preferences();
+        for (int k = 0; k < job->numPreferences(); ++k) {
+            int sid = prefs[k];
+            int sIdx = (sid >= 0 && sid <= maxId) ? serverIndexById_[sid] : -1;
+            if (sIdx < 0) continue;
+            int slot = prefOffset_[a] + k;
+            scoreAt_[slot] = priority_->scoreAt(*servers[sIdx], *job, k);
+            rankEntries_[sIdx].push_back({scoreAt_[slot], job->id(), slot});
+        }
+    }
+
+    for (auto& entries : rankEntries_) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const RankEntry& x, const RankEntry& y) {
+                      if (x.score != y.score) return x.score > y.score;
+                      return x.jobId < y.jobId;
+                  });
+        for (std::size_t r = 0; r < entries.size(); ++r) {
+            rankAt_[entries[r].slot] = static_cast<int>(r);
+        }
+    }
+
+    // does the table happen to be the common demand order?
+    //    every job scores the same everywhere, and (score desc, id) == (demand asc, id)
+    ranksFollowDemand_ = true;
+    order_.clear();
+    for (std::size_t a = 0; a < active_.size() && ranksFollowDemand_; ++a) {
+        bool any = false;
+        long long first = 0;
+        for (int slot = prefOffset_[a]; slot < prefOffset_[a + 1]; ++slot) {
+            if (rankAt_[slot] < 0) continue;
+            if (any && scoreAt_[slot] != first) ranksFollowDemand_ = false;
+            first = scoreAt_[slot];
+            any = true;
+        }
+        if (any) order_.push_back(active_[a]);
+    }
+    if (!ranksFollowDemand_) return;
+
+    std::sort(order_.begin(), order_.end(), serverPrefers);
+    auto commonScore = [this](const Job* job) {
+        int a = activeIndexById_[job->id()];
+        for (int slot = prefOffset_[a]; slot < prefOffset_[a + 1]; ++slot) {
+            if (rankAt_[slot] >= 0) return scoreAt_[slot];
+        }
+        return 0LL;
+    };
+    for (std::size_t i = 1; i < order_.size(); ++i) {
+        long long hi = commonScore(order_[i - 1]);
+        long long lo = commonScore(order_[i]);
+        if (hi < lo || (hi == lo && order_[i - 1]->id() > order_[i]->id())) {
+            ranksFollowDemand_ = false;
+            break;
+        }
+    }
+}
+
+// word-parallel subset sum: reach[i] = sums reachable with cands[i..], up to cap
+// take = the max-sum subset that is lexicographically first in priority order
+static void knapsackSelect(const std::vector<Job*>& cands, int cap,
+                           std::vector<std::uint64_t>& reach,
+                           std::vector<char>& take) {
+    const std::size_t n = cands.size();
+    const std::size_t words = static_cast<std::size_t>(cap) / 64 + 1;
+    const std::uint64_t lastMask = (cap % 64 == 63) ? ~0ULL : ((1ULL << (cap % 64 + 1)) - 1);
+    reach.assign((n + 1) * words, 0);
+    reach[n * words] = 1; // sum 0
+
+    auto row = [&](std::size_t i) { return reach.data() + i * words; };
+    auto has = [&](std::size_t i, int sum) {
+        return (row(i)[sum / 64] >> (sum % 64)) & 1ULL;
+    };
+
+    for (std::size_t i = n; i-- > 0; ) {
+        const std::uint64_t* src = row(i + 1);
+        std::uint64_t* dst = row(i);
+        int d = std::max(cands[i]->reportedDemand(), 0);
+        std::size_t ws = static_cast<std::size_t>(d) / 64;
+        int bs = d % 64;
+        for (std::size_t w = 0; w < words; ++w) {
+            std::uint64_t shifted = 0;
+            if (w >= ws) {
+                shifted = src[w - ws] << bs;
+                if (bs != 0 && w > ws) shifted |= src[w - ws - 1] >> (64 - bs);
             }
+            dst[w] = src[w] | shifted;
+        }
+        dst[words - 1] &= lastMask;
+    }
+
+    int target = cap;
+    while (target > 0 && !has(0, target)) --target;
 
-            newProps.clear();
+    take.assign(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        int d = std::max(cands[i]->reportedDemand(), 0);
+        if (d <= target && has(i + 1, target - d)) {
+            take[i] = 1;
+            target -= d;
         }
     }
+}
 
-    // S5. When DA converges, writeback matches to server and mark corresponding jobs as Running
-    for (std::size_t si = 0; si < servers.size(); ++si) {
-        Server* s = servers[si];
-        if (!s) continue;
+// one round at a knapsack server: keep the subset of held + proposed jobs
+// that fills the most capacity, prefer higher-priority jobs on ties
+void DAScheduler::knapsackRound(std::size_t si, int cap, std::vector<Job*>& newProps) {
+    auto t0 = std::chrono::steady_clock::now();
 
-        auto& curMatches = matches[si];
-        for (Job* job : curMatches) {
-            if (!job) continue;
-            if (job->isWaiting()) {
-                if (s->accept(job)) { 
-                    job->markRunning(currentTime);
-                    if (sim) sim->logJobStart(job, s, currentTime);
-                } else {
-                    job->markFailed(currentTime);
-                }
+    std::vector<Job*>& held = matches_[si];
+    std::vector<Job*>& cands = order_;
+    cands.assign(held.begin(), held.end());
+    for (Job* job : newProps) {
+        if (job->reportedDemand() > cap) {
+            job->advancePreference(); // can never fit here
+            continue;
+        }
+        cands.push_back(job);
+    }
+    std::sort(cands.begin(), cands.end(),
+              [this](const Job* a, const Job* b) { return rankOf(a) < rankOf(b); });
+
+    knapsackSelect(cands, cap, reach_, take_);
+
+    held.clear();
+    for (std::size_t i = 0; i < cands.size(); ++i) {
+        Job* job = cands[i];
+        if (take_[i]) {
+            held.push_back(job);
+            if (job->id() >= 0) heldById_[job->id()] = 1;
+        } else {
+            if (job->id() >= 0) heldById_[job->id()] = 0;
+            job->advancePreference();
+        }
+    }
+    newProps.clear();
+
+    ++knapsackRounds_;
+    knapsackSeconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void DAScheduler::resetStats() {
+    knapsackRounds_  = 0;
+    knapsackSeconds_ = 0.0;
+    greedyFallbacks_ = 0;
+    tableFallbacks_  = 0;
+    batches_    = 0;
+    rounds_     = 0;
+    maxRounds_  = 0;
+    maxBatchUs_ = 0.0;
+    budgetCuts_ = 0;
+    cutDecided_ = 0;
+    cutCarried_ = 0;
+    overruns_     = 0;
+    maxOverrunUs_ = 0.0;
+    shadowBatches_ = 0;
+    cutPlaced_  = 0;
+    fullPlaced_ = 0;
+    cutDemand_  = 0;
+    fullDemand_ = 0;
+}
+
+void DAScheduler::printStats() const {
+    if (acceptance_ == Acceptance::Knapsack) {
+        std::cout << "Knapsack acceptance: " << knapsackRounds_ << " server-rounds";
+        if (knapsackRounds_ > 0) {
+            std::cout << ", " << (1e6 * knapsackSeconds_ / knapsackRounds_) << " us each";
+        }
+        std::cout << ", greedy fallbacks: " << greedyFallbacks_ << " capacity > "
+                  << KNAPSACK_MAX_CAPACITY << ", " << tableFallbacks_ << " table > "
+                  << KNAPSACK_MAX_TABLE_WORDS << " words\n";
+    }
+    if (budget_.limited()) {
+        // end to end, carried jobs get extra chances at freed capacity, so the
+        // cut's cost is only visible against the uncut batch (shadow)
+        std::cout << "DA budget: cut " << budgetCuts_ << "/" << batches_ << " batches, rounds avg "
+                  << (batches_ > 0 ? static_cast<double>(rounds_) / batches_ : 0.0)
+                  << " max " << maxRounds_ << ", batch max " << maxBatchUs_ << " us";
+        if (budgetCuts_ > 0) {
+            std::cout << ", " << cutCarried_ << " jobs carried ("
+                      << (100.0 * cutCarried_ / (cutCarried_ + cutDecided_))
+                      << "% of the cut batches' jobs)";
+        }
+        std::cout << "\n";
+        if (budget_.maxUs > 0.0) {
+            // setup (rank tables), the last check interval and the commit are not cut
+            std::cout << "DA budget overrun: " << overruns_ << "/" << batches_
+                      << " batches over " << budget_.maxUs << " us, max overrun "
+                      << maxOverrunUs_ << " us\n";
+        }
+        if (shadowBatches_ > 0) {
+            std::cout << "DA budget vs uncut: placed " << cutPlaced_ << " of " << fullPlaced_
+                      << " jobs (" << (fullPlaced_ > 0 ? 100.0 * cutPlaced_ / fullPlaced_ : 100.0)
+                      << "%), matched demand " << cutDemand_ << " of " << fullDemand_ << " ("
+                      << (fullDemand_ > 0 ? 100.0 * cutDemand_ / fullDemand_ : 100.0)
+                      << "%) over " << shadowBatches_ << " cut batches\n";
+        }
+    }
+}
+
+// server id -> index (first index wins on duplicate ids), free capacity per index;
+// returns the largest server id
+int DAScheduler::indexServers(const std::vector<Server*>& servers) {
+    int maxId = 0;
+    for (Server* s : servers) {
+        if (s) maxId = std::max(maxId, s->id());
+    }
+    serverIndexById_.assign(maxId + 1, -1);
+    remaining_.assign(servers.size(), 0);
+    for (std::size_t si = servers.size(); si-- > 0; ) {
+        if (!servers[si]) continue;
+        serverIndexById_[servers[si]->id()] = static_cast<int>(si);
+        remaining_[si] = servers[si]->freeCapacity();
+    }
+    return maxId;
+}
+
+void DAScheduler::DemandPool::reset(int cap, int maxDemand) {
+    capacity = cap;
+    used = 0;
+    top = -1;
+    // a job above the capacity is never inserted, so this bounds the buckets
+    int n = std::max(std::min(cap, maxDemand), 0) + 1;
+    if (static_cast<int>(buckets.size()) < n) buckets.resize(n);
+    for (auto& b : buckets) b.clear();
+}
+
+// lower id = higher priority inside a bucket, so each bucket is a max-heap on id
+static bool idLess(const Job* a, const Job* b) {
+    return a->id() < b->id();
+}
+
+void DAScheduler::DemandPool::insert(Job* job) {
+    int d = std::max(job->reportedDemand(), 0);
+    buckets[d].push_back(job);
+    std::push_heap(buckets[d].begin(), buckets[d].end(), idLess);
+    used += d;
+    top = std::max(top, d);
+}
+
+Job* DAScheduler::DemandPool::evictLast() {
+    while (buckets[top].empty()) --top;
+    auto& b = buckets[top];
+    std::pop_heap(b.begin(), b.end(), idLess);
+    Job* job = b.back();
+    b.pop_back();
+    used -= top;
+    return job;
+}
+
+void DAScheduler::DemandPool::drain(std::vector<Job*>& out) {
+    for (int d = 0; d <= top; ++d) {
+        auto& b = buckets[d];
+        std::sort_heap(b.begin(), b.end(), idLess);
+        out.insert(out.end(), b.begin(), b.end());
+        b.clear();
+    }
+    top = -1;
+    used = 0;
+}
+
+// serial dictatorship: in priority order, each job takes the first server on its
+// list that still has room after everyone ranked above it. A wall-clock budget
+// stops the pass between jobs (checked every BUDGET_CHECK_EVERY jobs, at least
+// one job is placed or failed), the jobs not reached yet are carried
+void DAScheduler::runSerial(int currentTime, int maxId) {
+    std::vector<Job*>& order = order_;
+    order.assign(active_.begin(), active_.end());
+    std::sort(order.begin(), order.end());
+    order.erase(std::unique(order.begin(), order.end()), order.end());
+    std::sort(order.begin(), order.end(), serverPrefers);
+
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (budget_.maxUs > 0.0 && i > 0 && i % BUDGET_CHECK_EVERY == 0 && outOfTime()) {
+            carried_ = true;
+            break;
+        }
+        Job* job = order[i];
+        int d = job->reportedDemand();
+        while (true) {
+            int sid = job->nextPreferredServer();
+            if (sid < 0) {
+                job->markFailed(currentTime);
+                break;
+            }
+            int sIdx = (sid <= maxId) ? serverIndexById_[sid] : -1;
+            if (sIdx >= 0 && d <= remaining_[sIdx]) {
+                remaining_[sIdx] -= d;
+                matches_[sIdx].push_back(job); // in priority order, as the rounds leave it
+                break;
             }
+            job->advancePreference();
         }
     }
 }
+
+MemUsage DAScheduler::scratchUsage() const {
+    MemUsage u;
+    u.addVector(active_);
+    u.addVector(matches_);
+    u.addVector(proposals_);
+    u.addVector(order_);
+    u.addVector(serverIndexById_);
+    u.addVector(remaining_);
+    u.addVector(heldById_);
+    u.addVector(pools_);
+    u.addVector(activeIndexById_);
+    u.addVector(prefOffset_);
+    u.addVector(rankAt_);
+    u.addVector(scoreAt_);
+    u.addVector(rankEntries_);
+    u.addVector(merged_);
+    u.addVector(reach_);
+    u.addVector(take_);
+    u.addVector(startMarks_);
+    u.addVector(cutMarks_);
+    u.addVector(startRemaining_);
+    u.addVector(cutRemaining_);
+    u.addVector(cutMatches_);
+    for (const DemandPool& p : pools_) u.addVector(p.buckets);
+    return u;
+}
@@ -2,17 +2,169 @@
 #define DA_SCHEDULER_H
 
 #include "Scheduler.h"
+#include "Job.h"
 #include "Simulation.h"
+#include "ServerPriority.h"
 
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+
+// per-batch limit for anytime DA, 0 = unlimited
+struct DABudget {
+    int    maxRounds = 0;   // proposal / rejection rounds
+    double maxUs     = 0.0; // wall clock from the start of runBatch
+    // also run every cut batch to its fixed point (rewound afterwards) and
+    // compare placements; costs the full DA time, off the measured latency
+    bool   shadow    = false;
+    bool limited() const { return maxRounds > 0 || maxUs > 0.0; }
+};
+
+// Deferred acceptance, servers rank proposals with a PriorityRule
+// (default: smaller reported demand first, ties by id)
+// - Engine::Serial (default) computes the outcome in one ordered pass when the
+//   priority is the common demand order, otherwise the rounds run anyway
+// - Engine::Rounds runs the original proposal / rejection loop, kept as the
+//   reference the serial pass is checked against (mode=verify)
+// - any other rule is compiled into dense rank tables once per batch
+// - Acceptance::Greedy: a server fills its capacity in priority order
+// - Acceptance::Knapsack: a server keeps the subset that fills the most
+//   capacity (bitset subset sum, ties to higher priority); a server round
+//   falls back to greedy when the server has more than KNAPSACK_MAX_CAPACITY
+//   free or its table, (candidates + 1) x (free / 64 + 1) words, would pass
+//   KNAPSACK_MAX_TABLE_WORDS. Not a prefix rule, so it always runs the rounds
+// - with a DABudget the batch stops when the budget runs out (rounds between
+//   rounds, wall clock also inside a round, after at least one server has
+//   merged so every batch makes progress): tentatively held jobs are
+//   committed, the rest stay waiting with their preference iterator and
+//   resume where they stopped in the next batch (hasCarriedWork). Carried jobs
+//   fail later than in an uncut batch and see capacity freed meanwhile, so
+//   end-to-end results are not the cut's cost; DABudget::shadow measures it
 class DAScheduler : public Scheduler {
 public:
-    DAScheduler() = default;
+    enum class Engine { Serial, Rounds };
+    enum class Acceptance { Greedy, Knapsack };
+
+    static constexpr int KNAPSACK_MAX_CAPACITY = 1 << 14;
+    static constexpr std::size_t KNAPSACK_MAX_TABLE_WORDS = 1 << 20; // 8 MiB of reach_
+    static constexpr int BUDGET_CHECK_EVERY = 16; // jobs between clock reads
+
+    explicit DAScheduler(Engine engine = Engine::Serial,
+                         Acceptance acceptance = Acceptance::Greedy)
+        : engine_(engine), acceptance_(acceptance),
+          priority_(std::make_shared<DemandPriority>()) {}
     ~DAScheduler() override = default;
 
+    void setPriority(std::shared_ptr<const PriorityRule> rule) { priority_ = std::move(rule); }
+    void setBudget(const DABudget& budget) { budget_ = budget; }
+
+    bool hasCarriedWork() const override { return carried_; }
+    // cut points depend on the clock, carried iterators aren't in the trace
+    bool replayable() const override { return !budget_.limited(); }
+
     void runBatch(std::vector<Job*>& jobs,
                   std::vector<Server*>& servers,
                   int currentTime,
                   Simulation *sim) override;
+
+    void resetStats() override;
+    void printStats() const override;
+    MemUsage scratchUsage() const override;
+
+private:
+    Engine engine_;
+    Acceptance acceptance_;
+    std::shared_ptr<const PriorityRule> priority_;
+
+    long long knapsackRounds_  = 0;
+    double    knapsackSeconds_ = 0.0;
+    long long greedyFallbacks_ = 0; // capacity over KNAPSACK_MAX_CAPACITY
+    long long tableFallbacks_  = 0; // table over KNAPSACK_MAX_TABLE_WORDS
+
+    DABudget budget_;
+    std::chrono::steady_clock::time_point batchStart_;
+    bool carried_ = false;        // last batch was cut, its leftovers resume
+    long long batches_     = 0;
+    long long rounds_      = 0;
+    int       maxRounds_   = 0;   // most rounds in one batch
+    double    maxBatchUs_  = 0.0;
+    long long budgetCuts_  = 0;
+    long long cutDecided_  = 0;   // jobs placed or failed in cut batches
+    long long cutCarried_  = 0;   // jobs carried out of cut batches
+    long long overruns_    = 0;   // batches over maxUs
+    double    maxOverrunUs_ = 0.0;
+
+    // shadow: cut outcome vs the same batch run to its fixed point
+    struct JobMark {
+        JobState state;
+        int prefIndex;
+        int finishTime;
+    };
+    std::vector<JobMark> startMarks_, cutMarks_;
+    std::vector<int> startRemaining_, cutRemaining_;
+    std::vector<std::vector<Job*>> cutMatches_;
+    long long shadowBatches_ = 0;
+    long long cutPlaced_  = 0, fullPlaced_ = 0;
+    long long cutDemand_  = 0, fullDemand_ = 0;
+
+    // scratch buffers, kept across batches so steady-state batches don't allocate
+    std::vector<Job*> active_;
+    std::vector<std::vector<Job*>> matches_;
+    std::vector<std::vector<Job*>> proposals_;
+    std::vector<Job*> order_;
+    std::vector<int> serverIndexById_;
+    std::vector<int> remaining_;  // free capacity by server index
+    std::vector<char> heldById_;  // job id -> tentatively accepted somewhere
+
+    // a server's tentatively accepted jobs, bucketed by reported demand
+    struct DemandPool {
+        std::vector<std::vector<Job*>> buckets; // each a max-heap on job id
+        int top = -1;                           // highest non-empty bucket
+        int used = 0;
+        int capacity = 0;
+
+        void reset(int cap, int maxDemand);
+        void insert(Job* job);
+        Job* evictLast();                       // lowest priority job
+        void drain(std::vector<Job*>& out);     // appends in priority order, empties the pool
+    };
+    std::vector<DemandPool> pools_;
+
+    // rank tables, slot = prefOffset_[active index] + preference index
+    struct RankEntry {
+        long long score;
+        int jobId;
+        int slot;
+    };
+    std::vector<int> activeIndexById_;
+    std::vector<int> prefOffset_;
+    std::vector<int> rankAt_;          // rank at the slot's server, -1 = server not in batch
+    std::vector<long long> scoreAt_;
+    std::vector<std::vector<RankEntry>> rankEntries_; // per server, for sorting
+    bool ranksFollowDemand_ = false;
+    std::vector<Job*> merged_;
+
+    std::vector<std::uint64_t> reach_; // knapsack DP rows
+    std::vector<char> take_;
+
+    // rank of a proposing / held job at the server it is currently at
+    int rankOf(const Job* job) const;
+
+    int indexServers(const std::vector<Server*>& servers);
+    void compileRanks(const std::vector<Server*>& servers, int maxId);
+    int runEngine(std::vector<Server*>& servers, int currentTime, int maxId, bool demandOrder);
+    int runRounds(std::vector<Server*>& servers, int currentTime, int maxId, bool demandOrder);
+    void markActive(std::vector<JobMark>& out) const;
+    void rewindActive(const std::vector<JobMark>& marks);
+    void measureCut(std::vector<Server*>& servers, int currentTime, int maxId, bool demandOrder);
+    void runSerial(int currentTime, int maxId);
+    bool outOfBudget(int rounds) const;
+    bool outOfTime() const;
+    void poolRound(std::size_t si, std::vector<Job*>& newProps);
+    void rankedRound(std::size_t si, int cap, std::vector<Job*>& newProps);
+    void knapsackRound(std::size_t si, int cap, std::vector<Job*>& newProps);
 };
 
 #endif // DA_SCHEDULER_H
@@ -0,0 +1,149 @@
+#include "DRFScheduler.h"
+#include "Job.h"
+#include "Server.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+bool DRFScheduler::heapLess(int a, int b) const {
+    if (share_[a] != share_[b]) return share_[a] < share_[b];
+    return a < b;
+}
+
+void DRFScheduler::heapSwap(int i, int j) {
+    std::swap(heap_[i], heap_[j]);
+    heapPos_[heap_[i]] = i;
+    heapPos_[heap_[j]] = j;
+}
+
+void DRFScheduler::siftDown(int i) {
+    int n = static_cast<int>(heap_.size());
+    while (true) {
+        int best = i;
+        int l = 2 * i + 1;
+        int r = l + 1;
+        if (l < n && heapLess(heap_[l], heap_[best])) best = l;
+        if (r < n && heapLess(heap_[r], heap_[best])) best = r;
+        if (best == i) break;
+        heapSwap(i, best);
+        i = best;
+        ++heapOps_;
+    }
+}
+
+void DRFScheduler::heapRemoveTop() {
+    heapPos_[heap_[0]] = -1;
+    heap_[0] = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        heapPos_[heap_[0]] = 0;
+        siftDown(0);
+    }
+}
+
+void DRFScheduler::runBatch(std::vector<Job*>& jobs,
+                            std::vector<Server*>& servers,
+                            int currentTime,
+                            Simulation* sim)
+{
+    // S1. per-tenant queues of waiting jobs
+    int numTenants = 0;
+    int minDemand = INT_MAX;
+    for (Job* job : jobs) {
+        if (!job || !job->isWaiting() || job->reportedDemand() <= 0) continue;
+        numTenants = std::max(numTenants, job->tenant() + 1);
+        minDemand = std::min(minDemand, job->reportedDemand());
+    }
+    if (numTenants == 0) return;
+
+    double totalCap = 0.0;
+    for (Server* s : servers) {
+        if (!s) continue;
+        totalCap += s->capacity();
+        for (Job* job : s->assignedJobs()) {
+            if (job) numTenants = std::max(numTenants, job->tenant() + 1);
+        }
+    }
+    if (totalCap <= 0.0) return;
+    maxTenants_ = std::max(maxTenants_, numTenants);
+
+    share_.assign(numTenants, 0.0);
+    next_.assign(numTenants, 0);
+    heapPos_.assign(numTenants, -1);
+    if (static_cast<int>(queue_.size()) < numTenants) queue_.resize(numTenants);
+    for (int t = 0; t < numTenants; ++t) queue_[t].clear();
+    for (Job* job : jobs) {
+        if (!job || !job->isWaiting() || job->reportedDemand() <= 0 || job->tenant() < 0) continue;
+        queue_[job->tenant()].push_back(job);
+    }
+
+    // S2. dominant shares from what is running now
+    freeIndex_.build(servers);
+    for (Server* s : servers) {
+        if (!s) continue;
+        for (Job* job : s->assignedJobs()) {
+            if (job && job->isRunning() && job->tenant() >= 0) {
+                share_[job->tenant()] += job->trueDemand() / totalCap;
+            }
+        }
+    }
+
+    // O(tenants) heapify
+    heap_.clear();
+    for (int t = 0; t < numTenants; ++t) {
+        if (queue_[t].empty()) continue;
+        heapPos_[t] = static_cast<int>(heap_.size());
+        heap_.push_back(t);
+    }
+    for (int i = static_cast<int>(heap_.size()) / 2 - 1; i >= 0; --i) siftDown(i);
+
+    // S3. serve the lowest share, re-key that tenant only
+    while (!heap_.empty() && freeIndex_.maxKey() >= minDemand) {
+        int t = heap_[0];
+        Job* job = queue_[t][next_[t]++];
+
+        int si = freeIndex_.bestFit(job->reportedDemand());
+        if (si >= 0) {
+            Server* server = servers[si];
+            if (server->accept(job)) {
+                job->markRunning(currentTime);
+                if (sim) sim->logJobStart(job, server, currentTime);
+                share_[t] += job->trueDemand() / totalCap;
+                ++placed_;
+            } else {
+                job->markFailed(currentTime);
+            }
+            freeIndex_.set(si, server->freeCapacity());
+        }
+
+        if (next_[t] >= static_cast<int>(queue_[t].size())) {
+            heapRemoveTop();
+        } else {
+            siftDown(0); // share only grew
+        }
+    }
+}
+
+void DRFScheduler::resetStats() {
+    placed_  = 0;
+    heapOps_ = 0;
+    maxTenants_ = 0;
+}
+
+void DRFScheduler::printStats() const {
+    std::cout << "DRF placed " << placed_ << " jobs for up to " << maxTenants_
+              << " tenants, " << heapOps_ << " heap swaps\n";
+}
+
+MemUsage DRFScheduler::scratchUsage() const {
+    MemUsage u;
+    u.addVector(share_);
+    u.addVector(queue_);
+    u.addVector(next_);
+    u.addVector(heapPos_);
+    u.addVector(heap_);
+    u += freeIndex_.usage();
+    return u;
+}
@@ -0,0 +1,53 @@
+#ifndef DRF_SCHEDULER_H
+#define DRF_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "Simulation.h"
+#include "CapacityIndex.h"
+
+#include <vector>
+
+// Dominant Resource Fairness across tenants (Job::tenant())
+// - A tenant's dominant share = capacity it holds on running jobs / total
+//   capacity; with capacity as the only resource this is also its
+//   max-min fair share
+// - Tenants with waiting jobs sit in an indexed min-heap on that share
+//   (ties: lower tenant id). Every placement serves the lowest-share tenant's
+//   oldest job and re-keys only that tenant: O(log tenants)
+// - Placement is best-fit through a CapacityIndex; a job that fits nowhere
+//   stays Waiting and its tenant moves on to its next job
+class DRFScheduler : public Scheduler {
+public:
+    DRFScheduler() = default;
+    ~DRFScheduler() override = default;
+
+    void runBatch(std::vector<Job*>& jobs,
+                  std::vector<Server*>& servers,
+                  int currentTime,
+                  Simulation *sim) override;
+
+    void resetStats() override;
+    void printStats() const override;
+    MemUsage scratchUsage() const override;
+
+private:
+    // per tenant, indexed by tenant id
+    std::vector<double> share_;
+    std::vector<std::vector<Job*>> queue_; // waiting jobs, arrival order
+    std::vector<int> next_;                // first unserved job in queue_
+    std::vector<int> heapPos_;             // position in heap_, -1 = not queued
+
+    std::vector<int> heap_;                // tenant ids, min share on top
+    CapacityIndex freeIndex_;
+
+    long long placed_   = 0;
+    long long heapOps_  = 0;
+    int maxTenants_ = 0;
+
+    bool heapLess(int a, int b) const;
+    void heapSwap(int i, int j);
+    void siftDown(int i);
+    void heapRemoveTop();
+};
+
+#endif // DRF_SCHEDULER_H
@@ -0,0 +1,328 @@
+#include "Daemon.h"
+#include "Job.h"
+#include "Server.h"
+#include "Scheduler.h"
+#include "SchedulerFactory.h"
+#include "Distributions.h"
+#include "Trace.h"
+
+#include <thread>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+SchedulerDaemon::SchedulerDaemon(const GeneratorConfig& gen,
+                                 const DaemonConfig& cfg,
+                                 int batchSize,
+                                 const BatchPolicy& batch,
+                                 const DABudget& daBudget,
+                                 std::shared_ptr<const PriorityRule> daScores)
+    : gen_(gen),
+      cfg_(cfg),
+      batchSize_(batchSize),
+      batchPolicy_(batch),
+      daBudget_(daBudget)
+{
+    scheduler_ = makeScheduler(cfg_.scheduler, daBudget_, std::move(daScores));
+    if (!scheduler_) {
+        cfg_.scheduler = "da";
+        scheduler_ = makeScheduler(cfg_.scheduler);
+    }
+    if (cfg_.tickUs <= 0) cfg_.tickUs = 1;
+    if (cfg_.producers <= 0) cfg_.producers = 1;
+
+    DataGenerator generator(gen_);
+    generator.generateServers(servers_, serverArena_);
+}
+
+SchedulerDaemon::~SchedulerDaemon() = default;
+
+int SchedulerDaemon::currentTick() const {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_).count();
+    return static_cast<int>(us / cfg_.tickUs);
+}
+
+Job* SchedulerDaemon::makeJob(Arena& arena, int demand, int duration,
+                              const int* prefs, int numPrefs) {
+    int id = nextJobId_.fetch_add(1, std::memory_order_relaxed);
+    return arena.create<Job>(id, demand, demand, duration, currentTick(), prefs, numPrefs);
+}
+
+void SchedulerDaemon::submit(Submission* sub) {
+    sub->submitted = std::chrono::steady_clock::now();
+    queue_.push(sub);
+}
+
+void SchedulerDaemon::syntheticProducer(int idx) {
+    Arena& arena = *producerArenas_[idx];
+    std::mt19937 rng(gen_.seed + 7919u * static_cast<unsigned int>(idx + 1));
+    std::uniform_int_distribution<int> demandDist(gen_.demandMin, gen_.demandMax);
+    std::uniform_int_distribution<int> durationDist(gen_.durationMin, gen_.durationMax);
+    DistSpec demandSpec, durationSpec;
+    parseDistSpec(gen_.demandDist, demandSpec);
+    parseDistSpec(gen_.durationDist, durationSpec);
+    IntSampler demandSampler(demandSpec, gen_.demandMin, gen_.demandMax);
+    IntSampler durationSampler(durationSpec, gen_.durationMin, gen_.durationMax);
+
+    // open-loop arrivals: fixed schedule, a slow consumer does not slow producers
+    auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::micro>(1e6 / std::max(cfg_.ratePerSec, 1e-3)));
+    auto deadline = start_ + std::chrono::milliseconds(cfg_.durationMs);
+    auto next = std::chrono::steady_clock::now();
+
+    while (next < deadline) {
+        int* prefs = arena.allocArray<int>(gen_.numServers);
+        for (int s = 0; s < gen_.numServers; ++s) prefs[s] = s;
+        std::shuffle(prefs, prefs + gen_.numServers, rng);
+
+        Submission* sub = arena.create<Submission>();
+        int demand   = demandSpec.isUniform() ? demandDist(rng) : demandSampler(rng);
+        int duration = durationSpec.isUniform() ? durationDist(rng) : durationSampler(rng);
+        sub->job = makeJob(arena, demand, duration, prefs, gen_.numServers);
+        submit(sub);
+
+        next += interval;
+        if (next > std::chrono::steady_clock::now()) {
+            std::this_thread::sleep_until(next);
+        }
+    }
+    activeProducers_.fetch_sub(1, std::memory_order_release);
+}
+
+// one job per line: "demand duration [@slo] [tTenant] [serverId ...]", no list = all
+// servers in order, @slo = deadline in ticks after submission, tenant in
+// [0, numTenants) so per-tenant tables stay bounded; malformed lines are dropped
+void SchedulerDaemon::stdinProducer() {
+    Arena& arena = *producerArenas_[0];
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        const char* p = line.c_str();
+        char* end = nullptr;
+        long demand = std::strtol(p, &end, 10);
+        if (end == p) continue;
+        p = end;
+        long duration = std::strtol(p, &end, 10);
+        if (end == p) continue;
+        p = end;
+
+        long slo = -1;
+        long tenant = 0;
+        bool bad = false;
+        while (true) {
+            while (*p == ' ' || *p == '\t') ++p;
+            if (*p != '@' && *p != 't') break;
+            long v = std::strtol(p + 1, &end, 10);
+            if (end == p + 1) {
+                bad = true;
+                break;
+            }
+            if (*p == 't' && (v < 0 || v >= gen_.numTenants)) {
+                bad = true;
+                break;
+            }
+            (*p == '@' ? slo : tenant) = v;
+            p = end;
+        }
+        if (bad) continue;
+
+        std::vector<int> prefs;
+        while (true) {
+            long sid = std::strtol(p, &end, 10);
+            if (end == p) break;
+            p = end;
+            if (sid >= 0 && sid < gen_.numServers) prefs.push_back(static_cast<int>(sid));
+        }
+        if (prefs.empty()) {
+            for (int s = 0; s < gen_.numServers; ++s) prefs.push_back(s);
+        }
+
+        int* stored = arena.allocArray<int>(prefs.size());
+        std::copy(prefs.begin(), prefs.end(), stored);
+
+        Submission* sub = arena.create<Submission>();
+        sub->job = makeJob(arena, static_cast<int>(demand), static_cast<int>(duration),
+                           stored, static_cast<int>(prefs.size()));
+        if (slo >= 0) sub->job->setDeadline(sub->job->arrivalTime() + static_cast<int>(slo));
+        if (tenant > 0) sub->job->setTenant(static_cast<int>(tenant));
+        submit(sub);
+    }
+    activeProducers_.fetch_sub(1, std::memory_order_release);
+}
+
+void SchedulerDaemon::schedulerLoop() {
+    Trace::setThreadName("scheduler");
+    BatchController batcher(batchPolicy_, batchSize_);
+
+    std::vector<Job*> waiting;
+    std::vector<std::chrono::steady_clock::time_point> submitTimes; // by job id
+    std::vector<std::pair<Job*, int>> running;                      // job, serverId
+    std::vector<std::size_t> assignedBefore(servers_.size());
+
+    int lastTick = -1;
+
+    while (true) {
+        // read before draining: once producers are done, this drain sees every submission
+        bool producersDone = activeProducers_.load(std::memory_order_acquire) == 0;
+
+        // drain everything submitted so far
+        int arrived = 0;
+        while (Submission* sub = queue_.pop()) {
+            Job* job = sub->job;
+            if (static_cast<int>(submitTimes.size()) <= job->id()) {
+                submitTimes.resize(job->id() + 1);
+            }
+            submitTimes[job->id()] = sub->submitted;
+            waiting.push_back(job);
+            ++submitted_;
+            ++arrived;
+        }
+
+        int tick = currentTick();
+        if (arrived > 0) batcher.onArrivals(arrived, std::max(tick, lastTick + 1));
+
+        if (tick <= lastTick) {
+            // no more input, nothing running to free capacity, nothing new to batch
+            if (producersDone && running.empty() && !batcher.dirty()) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(std::max(cfg_.tickUs / 10, 1)));
+            continue;
+        }
+
+        // catch up tick by tick so batch boundaries are never skipped
+        for (int t = lastTick + 1; t <= tick; ++t) {
+            int freed = 0;
+            {
+                TRACE_SCOPE("updateFinishedJobs", t);
+                for (Server* s : servers_) freed += s->removeFinishedJobs(t, nullptr);
+            }
+            batcher.onCapacityFreed(freed);
+
+            if (freed > 0) {
+                std::size_t keep = 0;
+                for (auto& r : running) {
+                    if (r.first->isFinished()) {
+                        ++completed_;
+                        if (onCompletion_) onCompletion_({r.first->id(), r.second, t});
+                    } else {
+                        running[keep++] = r;
+                    }
+                }
+                running.resize(keep);
+            }
+
+            if (!batcher.due(t)) continue;
+            if (!batcher.dirty()) {
+                batcher.onSkip();
+                continue;
+            }
+
+            for (std::size_t si = 0; si < servers_.size(); ++si) {
+                assignedBefore[si] = servers_[si]->assignedJobs().size();
+            }
+
+            int queueIn = static_cast<int>(waiting.size());
+            {
+                TRACE_SCOPE("runBatch", queueIn);
+                scheduler_->runBatch(waiting, servers_, t, nullptr);
+            }
+            auto now = std::chrono::steady_clock::now();
+
+            // accept() appends, so new placements are the tail of each server's list
+            for (std::size_t si = 0; si < servers_.size(); ++si) {
+                const auto& assigned = servers_[si]->assignedJobs();
+                for (std::size_t k = assignedBefore[si]; k < assigned.size(); ++k) {
+                    Job* job = assigned[k];
+                    double lat = std::chrono::duration<double, std::micro>(
+                        now - submitTimes[job->id()]).count();
+                    latenciesUs_.push_back(lat);
+                    running.emplace_back(job, servers_[si]->id());
+                    ++placed_;
+                    if (onPlacement_) onPlacement_({job->id(), servers_[si]->id(), t, lat});
+                }
+            }
+
+            std::size_t keep = 0;
+            for (Job* job : waiting) {
+                if (job->isWaiting()) {
+                    waiting[keep++] = job;
+                } else if (job->isFailed()) {
+                    ++failed_;
+                    if (onPlacement_) onPlacement_({job->id(), -1, t, 0.0});
+                }
+            }
+            waiting.resize(keep);
+
+            batcher.onBatch(t, queueIn, static_cast<int>(waiting.size()), 0.0);
+            if (scheduler_->hasCarriedWork()) batcher.onCarry();
+        }
+        lastTick = tick;
+    }
+
+    unplaced_ = static_cast<long long>(waiting.size());
+    batches_ = batcher.batches();
+    skipped_ = batcher.skipped();
+}
+
+void SchedulerDaemon::run() {
+    int numProducers = (cfg_.input == "stdin") ? 1 : cfg_.producers;
+    producerArenas_.clear();
+    for (int i = 0; i < numProducers; ++i) {
+        producerArenas_.emplace_back(new Arena());
+    }
+    activeProducers_.store(numProducers);
+
+    start_ = std::chrono::steady_clock::now();
+
+    std::thread schedThread(&SchedulerDaemon::schedulerLoop, this);
+    std::vector<std::thread> producers;
+    if (cfg_.input == "stdin") {
+        producers.emplace_back(&SchedulerDaemon::stdinProducer, this);
+    } else {
+        for (int i = 0; i < numProducers; ++i) {
+            producers.emplace_back(&SchedulerDaemon::syntheticProducer, this, i);
+        }
+    }
+
+    for (auto& th : producers) th.join();
+    schedThread.join();
+
+    wallMs_ = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start_).count();
+}
+
+void SchedulerDaemon::printStats() const {
+    std::vector<double> lat = latenciesUs_;
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&lat](double q) -> double {
+        if (lat.empty()) return 0.0;
+        std::size_t idx = static_cast<std::size_t>(q * (lat.size() - 1));
+        return lat[idx];
+    };
+
+    std::cout << "=== Daemon (" << cfg_.scheduler << ", " << cfg_.input << ") ===\n"
+              << "Submitted jobs: " << submitted_ << "\n"
+              << "Placed jobs: "    << placed_    << "\n"
+              << "Failed jobs: "    << failed_    << "\n"
+              << "Completed jobs: " << completed_ << "\n"
+              << "Never placed: "   << unplaced_  << "\n"
+              << "Batches run/skipped: " << batches_ << "/" << skipped_ << "\n"
+              << "Wall time (ms): " << wallMs_ << "\n"
+              << "Submit->placement latency us (p50/p90/p99/max): "
+              << pct(0.50) << " / " << pct(0.90) << " / " << pct(0.99) << " / "
+              << (lat.empty() ? 0.0 : lat.back()) << "\n";
+    scheduler_->printStats();
+}
+
+bool runDaemonMode(const GeneratorConfig& gen,
+                   const DaemonConfig& cfg,
+                   int batchSize,
+                   const BatchPolicy& batch,
+                   const DABudget& daBudget,
+                   std::shared_ptr<const PriorityRule> daScores) {
+    SchedulerDaemon daemon(gen, cfg, batchSize, batch, daBudget, std::move(daScores));
+    daemon.run();
+    daemon.printStats();
+    return true;
+}
@@ -0,0 +1,126 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+
+#include "DataGenerator.h"
+#include "BatchController.h"
+#include "MpscQueue.h"
+#include "Arena.h"
+#include "DAScheduler.h"
+
+class Job;
+class Server;
+class Scheduler;
+
+struct DaemonConfig {
+    std::string scheduler = "da";        // see makeScheduler()
+    std::string input     = "synthetic"; // "synthetic" or "stdin"
+
+    int    producers  = 4;       // synthetic producer threads
+    double ratePerSec = 10000.0; // jobs per second per producer
+    int    durationMs = 2000;    // how long producers submit
+    int    tickUs     = 1000;    // wall-clock length of one simulation tick
+};
+
+// one submitted job travelling from a producer to the scheduler thread
+struct Submission {
+    Job* job = nullptr;
+    std::chrono::steady_clock::time_point submitted;
+    std::atomic<Submission*> next{nullptr};
+};
+
+struct PlacementEvent {
+    int jobId;
+    int serverId;   // -1 if the scheduler marked the job failed
+    int tick;
+    double latencyUs; // submit -> placement
+};
+
+struct CompletionEvent {
+    int jobId;
+    int serverId;
+    int tick;
+};
+
+// SchedulerDaemon：long-running online mode
+// - producer threads (synthetic load or a stdin reader) submit jobs through
+//   a lock-free MPSC queue, each producer allocates from its own Arena
+// - one scheduler thread drains the queue every tick, finishes jobs,
+//   and runs BaseScheduler / DAScheduler when the BatchController says so
+// - placements and completions are published through the callbacks
+//   (called on the scheduler thread)
+class SchedulerDaemon {
+public:
+    SchedulerDaemon(const GeneratorConfig& gen,
+                    const DaemonConfig& cfg,
+                    int batchSize,
+                    const BatchPolicy& batch,
+                    const DABudget& daBudget = DABudget(),
+                    std::shared_ptr<const PriorityRule> daScores = nullptr);
+    ~SchedulerDaemon();
+
+    void setPlacementCallback(std::function<void(const PlacementEvent&)> cb) { onPlacement_ = std::move(cb); }
+    void setCompletionCallback(std::function<void(const CompletionEvent&)> cb) { onCompletion_ = std::move(cb); }
+
+    // blocking: start producers + scheduler thread, wait until everything is done
+    void run();
+
+    // thread-safe, job must stay alive until the daemon is destroyed
+    void submit(Submission* sub);
+
+    void printStats() const;
+
+private:
+    GeneratorConfig gen_;
+    DaemonConfig cfg_;
+    int batchSize_;
+    BatchPolicy batchPolicy_;
+    DABudget daBudget_;
+
+    std::unique_ptr<Scheduler> scheduler_;
+
+    Arena serverArena_;
+    std::vector<Server*> servers_;
+    std::vector<std::unique_ptr<Arena>> producerArenas_;
+
+    MpscQueue<Submission> queue_;
+    std::atomic<int>  nextJobId_{0};
+    std::atomic<int>  activeProducers_{0};
+    std::chrono::steady_clock::time_point start_;
+
+    std::function<void(const PlacementEvent&)>  onPlacement_;
+    std::function<void(const CompletionEvent&)> onCompletion_;
+
+    // scheduler thread stats
+    long long submitted_ = 0;
+    long long placed_    = 0;
+    long long failed_    = 0;
+    long long completed_ = 0;
+    long long unplaced_  = 0;
+    std::vector<double> latenciesUs_;
+    int batches_ = 0;
+    int skipped_ = 0;
+    double wallMs_ = 0.0;
+
+    int currentTick() const;
+    Job* makeJob(Arena& arena, int demand, int duration, const int* prefs, int numPrefs);
+
+    void syntheticProducer(int idx);
+    void stdinProducer();
+    void schedulerLoop();
+};
+
+bool runDaemonMode(const GeneratorConfig& gen,
+                   const DaemonConfig& cfg,
+                   int batchSize,
+                   const BatchPolicy& batch,
+                   const DABudget& daBudget = DABudget(),
+                   std::shared_ptr<const PriorityRule> daScores = nullptr);
+
+#endif // DAEMON_H
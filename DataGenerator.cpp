@@ -1,6 +1,8 @@
 #include "DataGenerator.h"
 #include "Job.h"
 #include "Server.h"
+#include "Arena.h"
+#include "Distributions.h"
 
 #include <algorithm>
 #include <cmath>
@@ -16,7 +18,36 @@ static int randIntInRange(std::mt19937& rng,
     return dist(rng);
 }
 
-void DataGenerator::generateTrueJobs(std::vector<Job*>& outJobs) const {
+// arrival ticks of a Poisson / MMPP process, non-decreasing, numJobs of them
+static void drawArrivals(const GeneratorConfig& cfg, std::vector<int>& out) {
+    out.clear();
+    out.reserve(cfg.numJobs);
+    std::mt19937 rng(cfg.seed + 8111);
+
+    double mean = static_cast<double>(cfg.numJobs) / (std::max(cfg.maxArrivalTime, 0) + 1);
+    bool mmpp = (cfg.arrivalProcess == "mmpp");
+    double f = mmpp ? std::min(std::max(cfg.burstFraction, 0.0), 0.99) : 0.0;
+    double factor = std::max(cfg.burstRateFactor, 1.0);
+
+    // calm rate so that the long-run mean is still numJobs / (maxArrivalTime+1);
+    // leave a burst w.p. 1/burstLength, enter one w.p. chosen so bursts cover f
+    double calm = mean / (1.0 - f + factor * f);
+    std::poisson_distribution<int> calmCount(calm);
+    std::poisson_distribution<int> burstCount(calm * factor);
+    double leave = 1.0 / std::max(cfg.burstLength, 1.0);
+    std::bernoulli_distribution leaveBurst(leave);
+    std::bernoulli_distribution enterBurst(std::min(f / (1.0 - f) * leave, 1.0));
+
+    bool burst = false;
+    for (int t = 0; static_cast<int>(out.size()) < cfg.numJobs; ++t) {
+        if (mmpp) burst = burst ? !leaveBurst(rng) : enterBurst(rng);
+        int k = burst ? burstCount(rng) : calmCount(rng);
+        k = std::min(k, cfg.numJobs - static_cast<int>(out.size()));
+        out.insert(out.end(), k, t);
+    }
+}
+
+void DataGenerator::generateTrueJobs(std::vector<Job*>& outJobs, Arena& arena) const {
     outJobs.clear();
     outJobs.reserve(cfg_.numJobs);
 
@@ -26,49 +57,149 @@ void DataGenerator::generateTrueJobs(std::vector<Job*>& outJobs) const {
     std::uniform_int_distribution<int> durationDist(cfg_.durationMin, cfg_.durationMax);
     std::uniform_int_distribution<int> arrivalDist(0, cfg_.maxArrivalTime);
 
-    for (int j = 0; j < cfg_.numJobs; ++j) {
-        int trueDemand  = demandDist(rng);
-        int duration    = durationDist(rng);
-        int arrivalTime = arrivalDist(rng);
+    // S1. optional workload shapes, an unparsable spec stays uniform (Config warns);
+    //     with the defaults the draws below are exactly the uniform generator's
+    DistSpec demandSpec, durationSpec;
+    parseDistSpec(cfg_.demandDist, demandSpec);
+    parseDistSpec(cfg_.durationDist, durationSpec);
+    IntSampler demandSampler(demandSpec, cfg_.demandMin, cfg_.demandMax);
+    IntSampler durationSampler(durationSpec, cfg_.durationMin, cfg_.durationMax);
 
-        std::vector<int> prefs(cfg_.numServers);
+    std::vector<int> arrivals;
+    bool arrivalProcess = (cfg_.arrivalProcess == "poisson" || cfg_.arrivalProcess == "mmpp");
+    if (arrivalProcess) drawArrivals(cfg_, arrivals);
+
+    // popularity-weighted shuffle: sort by Exp(1) / weight (Efraimidis-Spirakis)
+    std::vector<double> popularity;
+    std::vector<std::pair<double, int>> keys;
+    std::exponential_distribution<double> expDist(1.0);
+    if (cfg_.prefSkew > 0.0) {
+        popularity.resize(cfg_.numServers);
         for (int s = 0; s < cfg_.numServers; ++s) {
-            prefs[s] = s;
+            popularity[s] = 1.0 / std::pow(s + 1.0, cfg_.prefSkew);
+        }
+        keys.resize(cfg_.numServers);
+    }
+
+    // S2. one job at a time
+    for (int j = 0; j < cfg_.numJobs; ++j) {
+        int trueDemand  = demandSpec.isUniform() ? demandDist(rng) : demandSampler(rng);
+        int duration    = durationSpec.isUniform() ? durationDist(rng) : durationSampler(rng);
+        int arrivalTime = arrivalProcess ? arrivals[j] : arrivalDist(rng);
+        if (cfg_.workflowSize > 1 && j % cfg_.workflowSize != 0) {
+            arrivalTime = outJobs[j - j % cfg_.workflowSize]->arrivalTime(); // same submission
+        }
+
+        int* prefs = arena.allocArray<int>(cfg_.numServers);
+        if (cfg_.prefSkew > 0.0) {
+            for (int s = 0; s < cfg_.numServers; ++s) {
+                keys[s] = {expDist(rng) / popularity[s], s};
+            }
+            std::sort(keys.begin(), keys.end());
+            for (int s = 0; s < cfg_.numServers; ++s) {
+                prefs[s] = keys[s].second;
+            }
+        } else {
+            for (int s = 0; s < cfg_.numServers; ++s) {
+                prefs[s] = s;
+            }
+            std::shuffle(prefs, prefs + cfg_.numServers, rng);
         }
-        std::shuffle(prefs.begin(), prefs.end(), rng);
-
-        Job* job = new Job(j,
-                           trueDemand,
-                           trueDemand,
-                           duration,
-                           arrivalTime,
-                           prefs);
+
+        Job* job = arena.create<Job>(j,
+                                     trueDemand,
+                                     trueDemand,
+                                     duration,
+                                     arrivalTime,
+                                     prefs,
+                                     cfg_.numServers);
         outJobs.push_back(job);
     }
+
+    if (cfg_.workflowSize > 1) makeWorkflows(outJobs, arena);
+
+    // own stream, so turning deadlines on leaves the workload unchanged
+    if (cfg_.deadlineProb > 0.0) {
+        std::mt19937 dlRng(cfg_.seed + 4051);
+        std::bernoulli_distribution hasDeadline(cfg_.deadlineProb);
+        for (Job* job : outJobs) {
+            if (!hasDeadline(dlRng)) continue;
+            int slack = randIntInRange(dlRng, cfg_.deadlineSlackMin, cfg_.deadlineSlackMax,
+                                       cfg_.deadlineSlackMin);
+            job->setDeadline(job->arrivalTime() + job->duration() + std::max(slack, 0));
+        }
+    }
+
+    if (cfg_.numTenants > 1) {
+        std::mt19937 tenantRng(cfg_.seed + 6151);
+        std::vector<double> weights(cfg_.numTenants);
+        for (int k = 0; k < cfg_.numTenants; ++k) {
+            weights[k] = 1.0 / std::pow(k + 1.0, cfg_.tenantSkew);
+        }
+        std::discrete_distribution<int> tenantDist(weights.begin(), weights.end());
+        for (Job* job : outJobs) job->setTenant(tenantDist(tenantRng));
+    }
+}
+
+// parents always come earlier in the group, so every workflow is acyclic
+// and job order is a topological order
+void DataGenerator::makeWorkflows(std::vector<Job*>& jobs, Arena& arena) const {
+    std::mt19937 rng(cfg_.seed + 9173);
+    std::bernoulli_distribution extraEdge(cfg_.workflowEdgeProb);
+    int K = cfg_.workflowSize;
+
+    std::vector<int> parents(jobs.size(), 0);
+    std::vector<std::vector<int>> children(K);
+    for (std::size_t first = 0; first < jobs.size(); first += K) {
+        int n = static_cast<int>(std::min<std::size_t>(K, jobs.size() - first));
+        for (auto& c : children) c.clear();
+
+        for (int k = 1; k < n; ++k) {
+            int must = std::uniform_int_distribution<int>(0, k - 1)(rng);
+            for (int p = 0; p < k; ++p) {
+                if (p == must || extraEdge(rng)) {
+                    children[p].push_back(jobs[first + k]->id());
+                    ++parents[first + k];
+                }
+            }
+        }
+        for (int k = 0; k < n; ++k) {
+            int* list = arena.allocArray<int>(children[k].size());
+            std::copy(children[k].begin(), children[k].end(), list);
+            jobs[first + k]->setDependencies(static_cast<int>(first / K), parents[first + k],
+                                             list, static_cast<int>(children[k].size()));
+        }
+    }
 }
 
 void DataGenerator::makeTruthfulCopy(const std::vector<Job*>& trueJobs,
-                                     std::vector<Job*>& outJobs) const {
+                                     std::vector<Job*>& outJobs,
+                                     Arena& arena) const {
     outJobs.clear();
     outJobs.reserve(trueJobs.size());
 
     for (const Job* src : trueJobs) {
         if (!src) continue;
 
-        Job* j = new Job(
+        Job* j = arena.create<Job>(
             src->id(),
             src->trueDemand(),
             /*reportedDemand=*/src->trueDemand(),
             src->duration(),
             src->arrivalTime(),
-            src->preferences()
+            src->preferences(),
+            src->numPreferences()
         );
+        j->setDeadline(src->deadline());
+        j->setTenant(src->tenant());
+        j->setDependencies(src->workflow(), src->numParents(), src->children(), src->numChildren());
         outJobs.push_back(j);
     }
 }
 
 void DataGenerator::makeStrategicCopy(const std::vector<Job*>& trueJobs,
-                                      std::vector<Job*>& outJobs) const {
+                                      std::vector<Job*>& outJobs,
+                                     Arena& arena) const {
     outJobs.clear();
     outJobs.reserve(trueJobs.size());
 
@@ -84,7 +215,6 @@ void DataGenerator::makeStrategicCopy(const std::vector<Job*>& trueJobs,
         int trueDemand  = src->trueDemand();
         int duration    = src->duration();
         int arrivalTime = src->arrivalTime();
-        auto prefs      = src->preferences();
 
         int reported = trueDemand;
 
@@ -112,19 +242,23 @@ void DataGenerator::makeStrategicCopy(const std::vector<Job*>& trueJobs,
             }
         }
 
-        Job* j = new Job(
+        Job* j = arena.create<Job>(
             id,
             trueDemand,
             reported,
             duration,
             arrivalTime,
-            prefs
+            src->preferences(),
+            src->numPreferences()
         );
+        j->setDeadline(src->deadline());
+        j->setTenant(src->tenant());
+        j->setDependencies(src->workflow(), src->numParents(), src->children(), src->numChildren());
         outJobs.push_back(j);
     }
 }
 
-void DataGenerator::generateServers(std::vector<Server*>& outServers) const {
+void DataGenerator::generateServers(std::vector<Server*>& outServers, Arena& arena) const {
     outServers.clear();
     outServers.reserve(cfg_.numServers);
 
@@ -133,7 +267,10 @@ void DataGenerator::generateServers(std::vector<Server*>& outServers) const {
 
     for (int s = 0; s < cfg_.numServers; ++s) {
         int cap = capDist(rng);
-        Server* server = new Server(s, cap);
+        Server* server = arena.create<Server>(s, cap, &arena);
+        int rack = (cfg_.serversPerRack > 0) ? s / cfg_.serversPerRack : 0;
+        int pod  = (cfg_.racksPerPod > 0) ? rack / cfg_.racksPerPod : 0;
+        server->setLocation(rack, pod);
         outServers.push_back(server);
     }
 }
@@ -3,9 +3,11 @@
 
 #include <vector>
 #include <random>
+#include <string>
 
 class Job;
 class Server;
+class Arena;
 
 struct GeneratorConfig {
     int numJobs          = 100;
@@ -22,6 +24,46 @@ struct GeneratorConfig {
 
     int maxArrivalTime   = 20;   // max arrival time
 
+    // workload shape (see Distributions.h), the defaults keep the uniform generator
+    // - demandDist / durationDist: e.g. "lognormal:1.5,0.8", "pareto:1.2", drawn in
+    //   [demandMin, demandMax] / [durationMin, durationMax]
+    // - arrivalProcess: "uniform" over [0, maxArrivalTime], or "poisson" / "mmpp"
+    //   ticks with Poisson counts at a mean rate of numJobs / (maxArrivalTime+1),
+    //   until numJobs have arrived (may run a little past maxArrivalTime)
+    // - mmpp: two-state Markov-modulated Poisson, bursts at burstRateFactor x the
+    //   calm rate, burstFraction of the ticks, burstLength ticks on average
+    // - prefSkew: server s is drawn into preference lists with weight
+    //   1 / (s+1)^prefSkew (weighted shuffle), 0 = uniform shuffle
+    std::string demandDist     = "uniform";
+    std::string durationDist   = "uniform";
+    std::string arrivalProcess = "uniform";
+    double burstRateFactor = 10.0;
+    double burstFraction   = 0.1;
+    double burstLength     = 5.0;
+    double prefSkew        = 0.0;
+
+    // topology: serversPerRack consecutive servers form a rack, racksPerPod
+    // consecutive racks a pod; 0 = one rack / one pod for everything
+    int serversPerRack = 0;
+    int racksPerPod    = 0;
+
+    // workflows: consecutive groups of workflowSize jobs are submitted together
+    // (at the first one's arrival) as a DAG; every later stage depends on one
+    // random earlier stage plus each other earlier stage w.p. workflowEdgeProb.
+    // 0 = independent jobs
+    int workflowSize        = 0;
+    double workflowEdgeProb = 0.2;
+
+    // SLO deadlines: a job gets one with probability deadlineProb, at
+    // arrival + duration + slack, slack uniform in [deadlineSlackMin, deadlineSlackMax]
+    double deadlineProb  = 0.0;
+    int deadlineSlackMin = 0;
+    int deadlineSlackMax = 10;
+
+    // tenants: job j belongs to tenant k with probability ~ 1 / (k+1)^tenantSkew
+    int numTenants     = 1;
+    double tenantSkew  = 0.0;  // 0 = uniform
+
     double misreportProb = 0.0;  // lie rate p
     double misreportAlpha= 0.0;  // lie degree α（0.5 stands for ±50%）
 
@@ -32,22 +74,29 @@ class DataGenerator {
 public:
     explicit DataGenerator(const GeneratorConfig& cfg);
 
+    // All objects are placed in 'arena' and released by arena.reset()
+
     // generate ground-truth jobs（trueDemand/arrival/duration）
-    void generateTrueJobs(std::vector<Job*>& outJobs) const;
+    void generateTrueJobs(std::vector<Job*>& outJobs, Arena& arena) const;
 
     // generate a full truly reported version base on GT
+    // (copies share the GT preference lists)
     void makeTruthfulCopy(const std::vector<Job*>& trueJobs,
-                          std::vector<Job*>& outJobs) const;
+                          std::vector<Job*>& outJobs,
+                          Arena& arena) const;
 
     // generate a strategically reported version base on GT
     void makeStrategicCopy(const std::vector<Job*>& trueJobs,
-                           std::vector<Job*>& outJobs) const;
+                           std::vector<Job*>& outJobs,
+                           Arena& arena) const;
 
     // generate server lists
-    void generateServers(std::vector<Server*>& outServers) const;
+    void generateServers(std::vector<Server*>& outServers, Arena& arena) const;
 
 private:
     GeneratorConfig cfg_;
+
+    void makeWorkflows(std::vector<Job*>& jobs, Arena& arena) const;
 };
 
 #endif // DATA_GENERATOR_H
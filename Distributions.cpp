@@ -0,0 +1,107 @@
+#include "Distributions.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <algorithm>
+
+AliasTable::AliasTable(const std::vector<double>& weights) {
+    std::size_t n = std::max<std::size_t>(weights.size(), 1);
+    double sum = 0.0;
+    for (double w : weights) sum += std::max(w, 0.0);
+
+    // S1. scale so the average bucket holds 1
+    std::vector<double> p(n, 1.0);
+    if (sum > 0.0) {
+        for (std::size_t i = 0; i < weights.size(); ++i) {
+            p[i] = std::max(weights[i], 0.0) * n / sum;
+        }
+    }
+
+    // S2. pair every underfull bucket with an overfull one
+    keep_.assign(n, 0);
+    alias_.assign(n, 0);
+    std::vector<int> small, large;
+    for (std::size_t i = 0; i < n; ++i) {
+        (p[i] < 1.0 ? small : large).push_back(static_cast<int>(i));
+    }
+    const double scale = 4294967296.0; // 2^32
+    while (!small.empty() && !large.empty()) {
+        int s = small.back();
+        small.pop_back();
+        int l = large.back();
+        keep_[s] = static_cast<std::uint64_t>(p[s] * scale);
+        alias_[s] = l;
+        p[l] -= 1.0 - p[s];
+        if (p[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // what is left is full up to rounding
+    for (int i : large) keep_[i] = static_cast<std::uint64_t>(scale);
+    for (int i : small) keep_[i] = static_cast<std::uint64_t>(scale);
+}
+
+bool parseDistSpec(const std::string& text, DistSpec& out) {
+    DistSpec spec;
+    std::size_t colon = text.find(':');
+    spec.kind = text.substr(0, colon);
+    if (colon != std::string::npos) {
+        std::stringstream ss(text.substr(colon + 1));
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            char* end = nullptr;
+            double v = std::strtod(item.c_str(), &end);
+            if (end == item.c_str()) return false;
+            spec.params.push_back(v);
+        }
+    }
+
+    std::size_t need;
+    if (spec.kind == "uniform") need = 0;
+    else if (spec.kind == "lognormal") need = 2;
+    else if (spec.kind == "pareto" || spec.kind == "zipf") need = 1;
+    else if (spec.kind == "empirical") need = 1; // at least one weight
+    else return false;
+
+    if (spec.kind == "empirical" ? spec.params.size() < need : spec.params.size() != need) {
+        return false;
+    }
+    if (spec.kind == "lognormal" && !(spec.params[1] > 0.0)) return false;
+    if (spec.kind == "pareto" && !(spec.params[0] > 0.0)) return false;
+
+    out = spec;
+    return true;
+}
+
+static double normalCdf(double z) {
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+}
+
+IntSampler::IntSampler(const DistSpec& spec, int lo, int hi)
+    : lo_(lo)
+{
+    int n = std::max(hi - lo + 1, 1);
+    std::vector<double> w(n, 1.0);
+
+    // mass of each integer value, the tails outside [lo, hi] are cut off
+    for (int i = 0; i < n; ++i) {
+        int v = lo + i;
+        if (spec.kind == "lognormal") {
+            double mu = spec.params[0], sigma = spec.params[1];
+            double a = v - 0.5, b = v + 0.5;
+            double fa = (a > 0.0) ? normalCdf((std::log(a) - mu) / sigma) : 0.0;
+            double fb = (b > 0.0) ? normalCdf((std::log(b) - mu) / sigma) : 0.0;
+            w[i] = fb - fa;
+        } else if (spec.kind == "pareto") {
+            double alpha = spec.params[0];
+            w[i] = std::pow(1.0 / (i + 1), alpha) - std::pow(1.0 / (i + 2), alpha);
+        } else if (spec.kind == "zipf") {
+            w[i] = 1.0 / std::pow(i + 1.0, spec.params[0]);
+        } else if (spec.kind == "empirical") {
+            w[i] = (i < static_cast<int>(spec.params.size())) ? spec.params[i] : 0.0;
+        }
+    }
+    table_ = AliasTable(w);
+}
@@ -0,0 +1,55 @@
+#ifndef DISTRIBUTIONS_H
+#define DISTRIBUTIONS_H
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+
+// Vose alias table: O(n) build, O(1) sample (two 32-bit draws, no floating point)
+class AliasTable {
+public:
+    AliasTable() = default;
+    explicit AliasTable(const std::vector<double>& weights); // all <= 0 -> uniform
+
+    int size() const { return static_cast<int>(alias_.size()); }
+
+    int sample(std::mt19937& rng) const {
+        std::uint64_t i = (static_cast<std::uint64_t>(rng()) * alias_.size()) >> 32;
+        return (rng() < keep_[i]) ? static_cast<int>(i) : alias_[i];
+    }
+
+private:
+    std::vector<std::uint64_t> keep_; // P(keep i) scaled to 2^32
+    std::vector<int> alias_;
+};
+
+// integer distribution from a config string, "name" or "name:p1,p2,..."
+//   uniform                  every value in the range
+//   lognormal:mu,sigma       ln(x) ~ N(mu, sigma), binned to the nearest integer
+//   pareto:alpha             x = lo + floor(X) - 1, X ~ Pareto(xm = 1, alpha)
+//   zipf:s                   P(lo + i) ~ 1 / (i+1)^s
+//   empirical:w0,w1,...      P(lo + i) ~ wi
+struct DistSpec {
+    std::string kind = "uniform";
+    std::vector<double> params;
+
+    bool isUniform() const { return kind == "uniform"; }
+};
+
+// false on an unknown name or missing / bad parameters, out is left unchanged
+bool parseDistSpec(const std::string& text, DistSpec& out);
+
+// spec truncated to [lo, hi] and compiled into an alias table
+class IntSampler {
+public:
+    IntSampler(const DistSpec& spec, int lo, int hi);
+
+    int operator()(std::mt19937& rng) const { return lo_ + table_.sample(rng); }
+
+private:
+    int lo_;
+    AliasTable table_;
+};
+
+#endif // DISTRIBUTIONS_H
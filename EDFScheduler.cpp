@@ -0,0 +1,88 @@
+#include "EDFScheduler.h"
+#include "Job.h"
+#include "Server.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+namespace {
+
+// deadline, jobs without one after every job with one
+long long deadlineKey(const Job* job) {
+    return job->hasDeadline() ? job->deadline() : LLONG_MAX;
+}
+
+// std heaps are max-heaps: "a after b" puts the earliest deadline on top
+bool edfAfter(const Job* a, const Job* b) {
+    long long da = deadlineKey(a);
+    long long db = deadlineKey(b);
+    if (da != db) return da > db;
+    if (a->arrivalTime() != b->arrivalTime()) return a->arrivalTime() > b->arrivalTime();
+    return a->id() > b->id();
+}
+
+} // namespace
+
+void EDFScheduler::runBatch(std::vector<Job*>& jobs,
+                            std::vector<Server*>& servers,
+                            int currentTime,
+                            Simulation* sim)
+{
+    ++batches_;
+
+    // S1. backlog heap
+    heap_.clear();
+    int minDemand = INT_MAX;
+    for (Job* job : jobs) {
+        if (!job || !job->isWaiting()) continue;
+        if (job->reportedDemand() <= 0) continue;
+        heap_.push_back(job);
+        minDemand = std::min(minDemand, job->reportedDemand());
+    }
+    if (heap_.empty()) return;
+    std::make_heap(heap_.begin(), heap_.end(), edfAfter);
+
+    // S2. capacity index
+    freeIndex_.build(servers);
+
+    // S3. earliest deadline first, best-fit
+    while (!heap_.empty() && freeIndex_.maxKey() >= minDemand) {
+        std::pop_heap(heap_.begin(), heap_.end(), edfAfter);
+        Job* job = heap_.back();
+        heap_.pop_back();
+        ++popped_;
+
+        int si = freeIndex_.bestFit(job->reportedDemand());
+        if (si < 0) continue; // fits nowhere, stays Waiting
+
+        Server* server = servers[si];
+        if (server->accept(job)) {
+            job->markRunning(currentTime);
+            if (sim) sim->logJobStart(job, server, currentTime);
+            ++placed_;
+        } else {
+            job->markFailed(currentTime);
+        }
+        freeIndex_.set(si, server->freeCapacity());
+    }
+}
+
+void EDFScheduler::resetStats() {
+    placed_  = 0;
+    popped_  = 0;
+    batches_ = 0;
+}
+
+void EDFScheduler::printStats() const {
+    std::cout << "EDF placed " << placed_ << " jobs with " << popped_
+              << " heap pops over " << batches_ << " batches\n";
+}
+
+MemUsage EDFScheduler::scratchUsage() const {
+    MemUsage u;
+    u.addVector(heap_);
+    u += freeIndex_.usage();
+    return u;
+}
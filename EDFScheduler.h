@@ -0,0 +1,40 @@
+#ifndef EDF_SCHEDULER_H
+#define EDF_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "Simulation.h"
+#include "CapacityIndex.h"
+
+#include <vector>
+
+// Earliest-deadline-first with best-fit placement
+// - The backlog is a binary heap ordered by deadline (jobs without one
+//   last), then arrival, then id; heapified once per batch in O(n)
+// - Placement is best-fit through a CapacityIndex, one lower_bound per job
+// - Jobs are popped in EDF order; a job that fits nowhere stays Waiting.
+//   Stops once no server can hold the smallest waiting demand, so a batch
+//   costs O(n + p log n) for p pops (p = placements + skipped jobs)
+class EDFScheduler : public Scheduler {
+public:
+    EDFScheduler() = default;
+    ~EDFScheduler() override = default;
+
+    void runBatch(std::vector<Job*>& jobs,
+                  std::vector<Server*>& servers,
+                  int currentTime,
+                  Simulation *sim) override;
+
+    void resetStats() override;
+    void printStats() const override;
+    MemUsage scratchUsage() const override;
+
+private:
+    std::vector<Job*> heap_;                   // EDF backlog of the current batch
+    CapacityIndex freeIndex_;
+
+    long long placed_ = 0;
+    long long popped_ = 0;
+    int batches_ = 0;
+};
+
+#endif // EDF_SCHEDULER_H
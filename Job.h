@@ -1,7 +1,6 @@
 #ifndef JOB_H
 #define JOB_H
 
-#include <vector>
 #include <cstddef> // std::size_t
 
 enum class JobState {
@@ -20,13 +19,15 @@ public:
         int reportedDemand,
         int duration,
         int arrivalTime,
-        const std::vector<int>& serverPrefs)
+        const int* serverPrefs,
+        int numPrefs)
         : id_(id),
           trueDemand_(trueDemand),
           reportedDemand_(reportedDemand),
           duration_(duration),
           arrivalTime_(arrivalTime),
           prefs_(serverPrefs),
+          numPrefs_(numPrefs),
           state_(JobState::Waiting),
           nextPrefIndex_(0),
           startTime_(-1),
@@ -41,14 +42,41 @@ public:
     int duration() const { return duration_; }
     int arrivalTime() const { return arrivalTime_; }
 
+    // absolute tick the job should finish by, -1 = none
+    int deadline() const { return deadline_; }
+    bool hasDeadline() const { return deadline_ >= 0; }
+
+    // owning team, 0 when there is only one
+    int tenant() const { return tenant_; }
+
+    // workflow DAG: the job becomes ready once its numParents() parents have
+    // finished; children() are the ids of the jobs waiting on it, not owned
+    // (copies of one job share the list like the preference list)
+    int workflow() const { return workflow_; } // -1 = independent job
+    int numParents() const { return numParents_; }
+    int pendingParents() const { return pendingParents_; }
+    const int* children() const { return children_; }
+    int numChildren() const { return numChildren_; }
+
     JobState state() const { return state_; }
     int startTime() const { return startTime_; }
     int finishTime() const { return finishTime_; }
 
-    const std::vector<int>& preferences() const { return prefs_; }
+    // preference list is not owned by the job, copies of one job share it
+    const int* preferences() const { return prefs_; }
+    int numPreferences() const { return numPrefs_; }
 
     // --- setters / state updates ---
     void setReportedDemand(int d) { reportedDemand_ = d; }
+    void setDeadline(int t) { deadline_ = t; }
+    void setTenant(int t) { tenant_ = t; }
+    void setDependencies(int workflow, int numParents, const int* children, int numChildren) {
+        workflow_ = workflow;
+        numParents_ = pendingParents_ = numParents;
+        children_ = children;
+        numChildren_ = numChildren;
+    }
+    void parentFinished() { --pendingParents_; }
 
     void markRunning(int currentTime) {
         state_ = JobState::Running;
@@ -77,7 +105,7 @@ public:
 
     // current proposed server id, if there is nothing left, return -1
     int nextPreferredServer() const {
-        if (nextPrefIndex_ >= prefs_.size()) {
+        if (nextPrefIndex_ >= static_cast<std::size_t>(numPrefs_)) {
             return -1;
         }
         return prefs_[nextPrefIndex_];
@@ -85,7 +113,7 @@ public:
 
     // after success/failed propose, move index
     void advancePreference() {
-        if (nextPrefIndex_ < prefs_.size()) {
+        if (nextPrefIndex_ < static_cast<std::size_t>(numPrefs_)) {
             ++nextPrefIndex_;
         }
     }
@@ -93,6 +121,16 @@ public:
     void resetPreferencesIter() {
         nextPrefIndex_ = 0;
     }
+
+    // undo a what-if DA pass (state, iterator, failure time), see DABudget::shadow
+    void rewindDA(JobState state, int prefIndex, int finishTime) {
+        state_ = state;
+        nextPrefIndex_ = static_cast<std::size_t>(prefIndex);
+        finishTime_ = finishTime;
+    }
+
+    // position of nextPreferredServer() in the list
+    int preferenceIndex() const { return static_cast<int>(nextPrefIndex_); }
     
     int waitingTime() const {
         if (finishTime_ < 0) return -1;
@@ -107,8 +145,17 @@ private:
 
     int duration_ = 0;       
     int arrivalTime_ = 0;    
+    int deadline_ = -1;
+    int tenant_ = 0;
+
+    int workflow_ = -1;
+    int numParents_ = 0;
+    int pendingParents_ = 0;
+    const int* children_ = nullptr;
+    int numChildren_ = 0;
 
-    std::vector<int> prefs_; 
+    const int* prefs_ = nullptr; 
+    int numPrefs_ = 0;
 
     JobState state_ = JobState::Waiting;
 
@@ -0,0 +1,179 @@
+#include "MatchingInstance.h"
+#include "Job.h"
+#include "Server.h"
+#include "Scheduler.h"
+#include "Arena.h"
+
+#include <algorithm>
+#include <utility>
+
+bool readLegacyInstance(std::istream& in, MatchingInstance& inst) {
+    int n, m;
+    if (!(in >> n >> m) || n < 0 || m < 0) return false;
+
+    inst.capacity.assign(n, 0);
+    for (int s = 0; s < n; ++s) {
+        if (!(in >> inst.capacity[s])) return false;
+    }
+
+    inst.demand.assign(m, 0);
+    inst.prefs.assign(m, {});
+    inst.scores.assign(m, {});
+    for (int j = 0; j < m; ++j) {
+        int L;
+        if (!(in >> inst.demand[j] >> L) || L < 0) return false;
+        inst.prefs[j].resize(L);
+        inst.scores[j].resize(L);
+        for (int k = 0; k < L; ++k) {
+            int s;
+            if (!(in >> s >> inst.scores[j][k])) return false;
+            if (s < 1 || s > n) return false;
+            inst.prefs[j][k] = s - 1;
+        }
+    }
+    return true;
+}
+
+void writeLegacyInstance(std::ostream& out, const MatchingInstance& inst) {
+    out << inst.numServers() << " " << inst.numJobs() << "\n";
+    for (int s = 0; s < inst.numServers(); ++s) {
+        out << (s ? " " : "") << inst.capacity[s];
+    }
+    out << "\n";
+    for (int j = 0; j < inst.numJobs(); ++j) {
+        out << inst.demand[j] << " " << inst.prefs[j].size();
+        for (std::size_t k = 0; k < inst.prefs[j].size(); ++k) {
+            out << " " << (inst.prefs[j][k] + 1) << " " << inst.scores[j][k];
+        }
+        out << "\n";
+    }
+}
+
+Matching solveLegacyDA(const MatchingInstance& inst) {
+    int n = inst.numServers();
+    int m = inst.numJobs();
+
+    // score of job j at server s, looked up through the job's own list;
+    // rows fill in job order so they come out sorted, and a server listed
+    // twice keeps its last score, like the legacy unordered_map
+    std::vector<std::vector<std::pair<int, long long>>> scoreAt(n);
+    for (int j = 0; j < m; ++j) {
+        for (std::size_t k = 0; k < inst.prefs[j].size(); ++k) {
+            auto& row = scoreAt[inst.prefs[j][k]];
+            if (!row.empty() && row.back().first == j) {
+                row.back().second = inst.scores[j][k];
+            } else {
+                row.emplace_back(j, inst.scores[j][k]);
+            }
+        }
+    }
+    auto scoreOf = [&scoreAt](int s, int j) -> long long {
+        auto it = std::lower_bound(scoreAt[s].begin(), scoreAt[s].end(),
+                                   std::make_pair(j, (long long)0),
+                                   [](const std::pair<int, long long>& a,
+                                      const std::pair<int, long long>& b) {
+                                       return a.first < b.first;
+                                   });
+        return it->second;
+    };
+
+    std::vector<int> ptr(m, 0);
+    Matching current(m, -1);
+    std::vector<std::vector<int>> assigned(n);
+
+    while (true) {
+        std::vector<std::vector<int>> proposals(n);
+        bool hasNewProposal = false;
+
+        // Proposal phase: only unmatched jobs with remaining preferences propose
+        for (int j = 0; j < m; ++j) {
+            if (current[j] != -1) continue;
+            if (ptr[j] >= static_cast<int>(inst.prefs[j].size())) continue;
+            int s = inst.prefs[j][ptr[j]];
+            ++ptr[j];
+            proposals[s].push_back(j);
+            hasNewProposal = true;
+        }
+
+        if (!hasNewProposal) break;
+
+        // Server response phase
+        for (int s = 0; s < n; ++s) {
+            if (proposals[s].empty()) continue;
+
+            std::vector<std::pair<long long, int>> cand;
+            cand.reserve(assigned[s].size() + proposals[s].size());
+            for (int j : assigned[s]) cand.emplace_back(scoreOf(s, j), j);
+            for (int j : proposals[s]) cand.emplace_back(scoreOf(s, j), j);
+
+            std::sort(cand.begin(), cand.end(),
+                      [](const std::pair<long long, int>& a,
+                         const std::pair<long long, int>& b) {
+                          if (a.first != b.first) return a.first > b.first;
+                          return a.second < b.second;
+                      });
+
+            // Greedily accept jobs while respecting capacity
+            long long used = 0;
+            std::vector<int> newAssigned;
+            for (auto& p : cand) {
+                int j = p.second;
+                if (used + inst.demand[j] <= inst.capacity[s]) {
+                    used += inst.demand[j];
+                    newAssigned.push_back(j);
+                }
+            }
+
+            for (int j : assigned[s]) current[j] = -1;
+            for (int j : newAssigned) current[j] = s;
+            assigned[s].swap(newAssigned);
+        }
+    }
+
+    return current;
+}
+
+Matching solveWithScheduler(Scheduler& sched, const MatchingInstance& inst, Arena& arena) {
+    std::vector<Server*> servers;
+    servers.reserve(inst.numServers());
+    for (int s = 0; s < inst.numServers(); ++s) {
+        servers.push_back(arena.create<Server>(s, inst.capacity[s], &arena));
+    }
+
+    std::vector<Job*> jobs;
+    jobs.reserve(inst.numJobs());
+    for (int j = 0; j < inst.numJobs(); ++j) {
+        int L = static_cast<int>(inst.prefs[j].size());
+        int* prefs = arena.allocArray<int>(L);
+        std::copy(inst.prefs[j].begin(), inst.prefs[j].end(), prefs);
+        jobs.push_back(arena.create<Job>(j, inst.demand[j], inst.demand[j],
+                                         /*duration=*/1, /*arrivalTime=*/0, prefs, L));
+    }
+
+    sched.runBatch(jobs, servers, 0, nullptr);
+
+    Matching match(inst.numJobs(), -1);
+    for (Server* s : servers) {
+        for (Job* job : s->assignedJobs()) {
+            match[job->id()] = s->id();
+        }
+    }
+    return match;
+}
+
+std::shared_ptr<PreferenceScorePriority> instancePriority(const MatchingInstance& inst) {
+    auto rule = std::make_shared<PreferenceScorePriority>();
+    std::vector<int> lastSlot(inst.numServers(), -1);
+    std::vector<long long> scores;
+    for (int j = 0; j < inst.numJobs(); ++j) {
+        // a server listed twice keeps its last score in every slot, like the
+        // legacy unordered_map
+        const std::vector<int>& prefs = inst.prefs[j];
+        for (std::size_t k = 0; k < prefs.size(); ++k) lastSlot[prefs[k]] = static_cast<int>(k);
+        scores.resize(prefs.size());
+        for (std::size_t k = 0; k < prefs.size(); ++k) scores[k] = inst.scores[j][lastSlot[prefs[k]]];
+        for (int s : prefs) lastSlot[s] = -1;
+        rule->addJob(scores);
+    }
+    return rule;
+}
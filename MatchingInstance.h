@@ -0,0 +1,49 @@
+#ifndef MATCHING_INSTANCE_H
+#define MATCHING_INSTANCE_H
+
+#include <vector>
+#include <memory>
+#include <istream>
+#include <ostream>
+
+#include "ServerPriority.h"
+
+class Scheduler;
+class Arena;
+
+// One many-to-one matching problem, the same data as the legacy
+// final_project.cpp input (but 0-based)
+struct MatchingInstance {
+    std::vector<int> capacity;                  // per server
+    std::vector<int> demand;                    // per job
+    std::vector<std::vector<int>> prefs;        // per job, server indices, best first
+    std::vector<std::vector<long long>> scores; // per job, score at prefs[j][k] (higher = server prefers)
+
+    int numServers() const { return static_cast<int>(capacity.size()); }
+    int numJobs() const { return static_cast<int>(demand.size()); }
+};
+
+// match[j] = server index, -1 = unmatched
+using Matching = std::vector<int>;
+
+// legacy text format (1-based server ids):
+//   n m
+//   C_1 ... C_n
+//   per job: w L s_1 score_1 ... s_L score_L
+bool readLegacyInstance(std::istream& in, MatchingInstance& inst);
+void writeLegacyInstance(std::ostream& out, const MatchingInstance& inst);
+
+// independent reference: the DA loop of legacy/final_project.cpp
+// (servers rank by score desc, then job index asc)
+Matching solveLegacyDA(const MatchingInstance& inst);
+
+// run one runBatch of 'sched' on the instance (jobs with id = index,
+// reported = true demand = demand[j]), objects are placed in 'arena'
+Matching solveWithScheduler(Scheduler& sched, const MatchingInstance& inst, Arena& arena);
+
+// the instance's scores as a DA priority (server id = index, job id = index),
+// looked up by preference slot; a server listed twice scores its last entry
+// in both slots
+std::shared_ptr<PreferenceScorePriority> instancePriority(const MatchingInstance& inst);
+
+#endif // MATCHING_INSTANCE_H
@@ -0,0 +1,120 @@
+#include "MemStats.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+const char* memSubsystemName(int s) {
+    static const char* names[MEM_NUM] = {"generator", "jobs", "servers", "scheduler", "trace"};
+    return (s >= 0 && s < MEM_NUM) ? names[s] : "?";
+}
+
+namespace {
+
+#if defined(__linux__)
+// "VmRSS:" / "VmHWM:" from /proc/self/status, in bytes
+long long procStatusBytes(const char* key) {
+    std::ifstream fin("/proc/self/status");
+    std::string line;
+    while (std::getline(fin, line)) {
+        if (line.compare(0, std::char_traits<char>::length(key), key) == 0) {
+            std::istringstream ss(line.substr(std::char_traits<char>::length(key)));
+            long long kb = 0;
+            ss >> kb;
+            return kb * 1024;
+        }
+    }
+    return 0;
+}
+#endif
+
+} // namespace
+
+long long currentRssBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return static_cast<long long>(pmc.WorkingSetSize);
+    }
+    return 0;
+#elif defined(__linux__)
+    return procStatusBytes("VmRSS:");
+#else
+    return 0;
+#endif
+}
+
+long long peakRssBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return static_cast<long long>(pmc.PeakWorkingSetSize);
+    }
+    return 0;
+#elif defined(__linux__)
+    return procStatusBytes("VmHWM:");
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<long long>(ru.ru_maxrss);        // bytes
+#else
+    return static_cast<long long>(ru.ru_maxrss) * 1024; // KiB
+#endif
+#endif
+}
+
+void resetPeakRss() {
+#if defined(__linux__)
+    // "5" resets VmHWM to the current RSS (Linux >= 4.0)
+    std::ofstream out("/proc/self/clear_refs");
+    if (out) out << "5";
+#endif
+}
+
+void MemReport::beginPhase() {
+    if (!enabled_) return;
+    current_ = Phase();
+    resetPeakRss();
+}
+
+void MemReport::endPhase(const std::string& name) {
+    if (!enabled_) return;
+    current_.name    = name;
+    current_.rss     = currentRssBytes();
+    current_.peakRss = peakRssBytes();
+    phases_.push_back(current_);
+    current_ = Phase();
+    resetPeakRss();
+}
+
+void MemReport::print() const {
+    auto mib = [](long long b) { return b / (1024.0 * 1024.0); };
+
+    std::ios oldState(nullptr);
+    oldState.copyfmt(std::cout);
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "=== Memory (MiB, allocations) ===\n";
+    for (const Phase& p : phases_) {
+        std::cout << std::left << std::setw(20) << p.name << std::right
+                  << " rss " << std::setw(9) << mib(p.rss)
+                  << " peak " << std::setw(9) << mib(p.peakRss);
+        for (int s = 0; s < MEM_NUM; ++s) {
+            if (p.usage[s].allocs == 0 && p.usage[s].bytes == 0) continue;
+            std::cout << "  " << memSubsystemName(s) << " " << mib(p.usage[s].bytes)
+                      << " (" << p.usage[s].allocs << ")";
+        }
+        std::cout << "\n";
+    }
+    std::cout.copyfmt(oldState);
+}
@@ -0,0 +1,93 @@
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <string>
+#include <vector>
+
+// subsystems memory is charged to
+enum MemSubsystem {
+    MEM_GENERATOR = 0, // ground-truth jobs + preference lists
+    MEM_JOBS,          // per-scenario job copies
+    MEM_SERVERS,       // servers + their assigned-job lists
+    MEM_SCHEDULER,     // scheduler scratch buffers
+    MEM_TRACE,         // run records, occupancy timelines, replay trace
+    MEM_NUM
+};
+
+const char* memSubsystemName(int s);
+
+// live allocations and bytes of one subsystem
+// - arena-backed subsystems: arena allocations made in the phase
+// - container-backed ones: one allocation per non-empty buffer, bytes = capacity
+struct MemUsage {
+    long long allocs = 0;
+    long long bytes  = 0;
+
+    template <typename T>
+    void addVector(const std::vector<T>& v) {
+        if (v.capacity() == 0) return;
+        ++allocs;
+        bytes += static_cast<long long>(v.capacity() * sizeof(T));
+    }
+
+    template <typename T>
+    void addVector(const std::vector<std::vector<T>>& v) {
+        if (v.capacity() == 0) return;
+        ++allocs;
+        bytes += static_cast<long long>(v.capacity() * sizeof(std::vector<T>));
+        for (const auto& inner : v) addVector(inner);
+    }
+
+    MemUsage& operator+=(const MemUsage& o) {
+        allocs += o.allocs;
+        bytes  += o.bytes;
+        return *this;
+    }
+    MemUsage& operator-=(const MemUsage& o) {
+        allocs -= o.allocs;
+        bytes  -= o.bytes;
+        return *this;
+    }
+};
+
+// process resident set size in bytes, 0 if unknown
+long long currentRssBytes();
+long long peakRssBytes();
+// restart peak tracking so the next peakRssBytes() covers one phase only
+// (Linux; elsewhere the peak is process-wide)
+void resetPeakRss();
+
+// MemReport：opt-in per-phase accounting of one seed (memStats=1)
+// - charge() adds usage to the phase in progress
+// - endPhase() closes it with the current and peak RSS
+// - everything is a no-op when disabled
+class MemReport {
+public:
+    explicit MemReport(bool enabled) : enabled_(enabled) {}
+
+    struct Phase {
+        std::string name;
+        MemUsage usage[MEM_NUM];
+        long long rss     = 0;
+        long long peakRss = 0;
+    };
+
+    bool enabled() const { return enabled_; }
+
+    void beginPhase();
+    void charge(MemSubsystem s, const MemUsage& u) {
+        if (enabled_) current_.usage[s] += u;
+    }
+    void endPhase(const std::string& name);
+
+    const std::vector<Phase>& phases() const { return phases_; }
+    void clear() { phases_.clear(); }
+    void print() const;
+
+private:
+    bool enabled_;
+    Phase current_;
+    std::vector<Phase> phases_;
+};
+
+#endif // MEM_STATS_H
@@ -1,10 +1,34 @@
 #include "Metrics.h"
 #include <iostream>
+#include <algorithm>
 
 void Metrics::print() const {
     std::cout << "Total jobs: "        << totalJobs       << "\n"
               << "Finished jobs: "     << finishedJobs    << "\n"
               << "Avg completion time: " << avgCompletionTime << "\n"
               << "Avg waiting time: "    << avgWaitingTime    << "\n"
-              << "Approx avg utilization: " << avgUtilization << "\n";
+              << "Approx avg utilization: " << avgUtilization << "\n"
+              << "Waiting p95/max (incl. never started): " << waitingP95 << " / " << maxWaitingTime << "\n"
+              << "Batches run/skipped: " << numBatches << "/" << skippedBatches
+              << " (max delay " << maxBatchDelay << ")\n";
+    if (deadlineJobs > 0) {
+        std::cout << "Deadline misses: " << deadlineMisses << "/" << deadlineJobs
+                  << " (" << (100.0 * missRate) << "%)\n"
+                  << "Lateness p50/p95/p99: " << latenessP50 << " / "
+                  << latenessP95 << " / " << latenessP99 << "\n";
+    }
+    if (workflows > 0) {
+        std::cout << "Workflows done: " << workflowsDone << "/" << workflows
+                  << ", makespan avg " << makespanAvg << ", critical-path stretch mean/p95 "
+                  << stretchMean << " / " << stretchP95 << "\n";
+    }
+    if (tenants.size() > 1) {
+        double minShare = tenants[0].share, maxShare = tenants[0].share;
+        for (const TenantMetrics& t : tenants) {
+            minShare = std::min(minShare, t.share);
+            maxShare = std::max(maxShare, t.share);
+        }
+        std::cout << "Tenants: " << tenants.size() << ", share min/max " << minShare
+                  << " / " << maxShare << ", Jain's index " << jainIndex << "\n";
+    }
 }
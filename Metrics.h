@@ -1,6 +1,18 @@
 #ifndef METRICS_H
 #define METRICS_H
 
+#include <vector>
+
+// one tenant's slice of a run, capacity-ticks use true demand
+struct TenantMetrics {
+    int jobs     = 0;
+    int finished = 0;
+    double usage     = 0.0; // capacity-ticks run within the horizon
+    double requested = 0.0; // sum of demand * duration
+    double share     = 0.0; // usage / all tenants' usage
+    double served    = 0.0; // usage / requested
+};
+
 struct Metrics {
     int totalJobs = 0;
     int finishedJobs = 0;
@@ -10,6 +22,35 @@ struct Metrics {
 
     double avgUtilization    = 0.0; 
 
+    // over all jobs, never started = waited until timeLimit+1
+    double waitingP95     = 0.0;
+    int    maxWaitingTime = 0;
+
+    int numBatches     = 0; // runBatch calls
+    int skippedBatches = 0; // due batches skipped, nothing changed
+    int maxBatchDelay  = 0; // max ticks from arrival to first batch
+
+    // jobs with a deadline only; unfinished jobs count as finishing at timeLimit+1
+    int deadlineJobs   = 0;
+    int deadlineMisses = 0;    // finished after the deadline, or not at all
+    double missRate    = 0.0;  // deadlineMisses / deadlineJobs
+    double latenessP50 = 0.0;  // finish - deadline (negative = early)
+    double latenessP95 = 0.0;
+    double latenessP99 = 0.0;
+
+    // fairness, filled when jobs carry more than one tenant id;
+    // Jain's index over the tenants' served fractions (1 = perfectly even)
+    std::vector<TenantMetrics> tenants;
+    double jainIndex = 1.0;
+
+    // workflow DAGs, over workflows whose every job finished;
+    // stretch = makespan / critical path (longest duration chain)
+    int workflows     = 0;
+    int workflowsDone = 0;
+    double makespanAvg = 0.0; // last finish - submission
+    double stretchMean = 0.0;
+    double stretchP95  = 0.0;
+
     void print() const;
 };
 
@@ -0,0 +1,65 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+
+// Intrusive lock-free multi-producer / single-consumer queue (Vyukov)
+// - T must be default constructible and have a member
+//     std::atomic<T*> next;
+// - push() is wait-free and may be called from any thread
+// - pop() must only be called from the single consumer thread, it returns
+//   nullptr when the queue is empty (or a producer is halfway through push)
+// - the queue never owns or frees nodes
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {
+        stub_.next.store(nullptr, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        T* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    T* pop() {
+        T* tail = tail_;
+        T* next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &stub_) {
+            if (!next) return nullptr;
+            tail_ = next;
+            tail  = next;
+            next  = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return nullptr; // producer has swapped head but not linked yet
+        }
+
+        // tail is the last node: re-insert the stub so it can be handed out
+        push(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+private:
+    std::atomic<T*> head_;
+    T* tail_;
+    T  stub_;
+};
+
+#endif // MPSC_QUEUE_H
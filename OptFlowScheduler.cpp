@@ -0,0 +1,253 @@
+#include "OptFlowScheduler.h"
+#include "Job.h"
+#include "Server.h"
+#include "Simulation.h"
+
+#include <limits>
+#include <climits>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+const long long INF_DIST = std::numeric_limits<long long>::max() / 4;
+
+const int SOURCE = 0;
+const int SINK   = 1;
+
+} // namespace
+
+void OptFlowScheduler::addEdge(int from, int to, int cap, int cost) {
+    // forward edge at an even index, its reverse right after (e ^ 1)
+    edges_.push_back({to, cap, cost});
+    edgeNext_.push_back(head_[from]);
+    head_[from] = static_cast<int>(edges_.size()) - 1;
+
+    edges_.push_back({from, 0, -cost});
+    edgeNext_.push_back(head_[to]);
+    head_[to] = static_cast<int>(edges_.size()) - 1;
+}
+
+// primal-dual min-cost max-flow:
+// Dijkstra on reduced costs, then push as much as possible along
+// zero reduced-cost paths before the next Dijkstra.
+// Costs are preference ranks (small integers), so Dijkstra uses a
+// bucket queue (Dial) instead of a heap: O(E + max distance) per phase
+int OptFlowScheduler::minCostMaxFlow(int source, int sink, int numNodes) {
+    potential_.assign(numNodes, 0);
+    std::vector<int> curArc(numNodes);
+    std::vector<char> onPath(numNodes, 0);
+
+    std::function<int(int, int)> augment = [&](int u, int limit) -> int {
+        if (u == sink) return limit;
+        onPath[u] = 1;
+        for (int& e = curArc[u]; e != -1; e = edgeNext_[e]) {
+            Edge& ed = edges_[e];
+            if (ed.cap <= 0 || onPath[ed.to]) continue;
+            if (ed.cost + potential_[u] - potential_[ed.to] != 0) continue;
+            int pushed = augment(ed.to, std::min(limit, ed.cap));
+            if (pushed > 0) {
+                ed.cap -= pushed;
+                edges_[e ^ 1].cap += pushed;
+                onPath[u] = 0;
+                return pushed;
+            }
+        }
+        onPath[u] = 0;
+        return 0;
+    };
+
+    int flow = 0;
+    while (true) {
+        dist_.assign(numNodes, INF_DIST);
+        for (auto& b : buckets_) b.clear();
+        dist_[source] = 0;
+        if (buckets_.empty()) buckets_.resize(1);
+        buckets_[0].push_back(source);
+
+        for (std::size_t d = 0; d < buckets_.size(); ++d) {
+            // zero reduced-cost edges append to the bucket being scanned
+            for (std::size_t i = 0; i < buckets_[d].size(); ++i) {
+                int u = buckets_[d][i];
+                if (dist_[u] != static_cast<long long>(d)) continue;
+                for (int e = head_[u]; e != -1; e = edgeNext_[e]) {
+                    const Edge& ed = edges_[e];
+                    if (ed.cap <= 0) continue;
+                    long long nd = static_cast<long long>(d) + ed.cost + potential_[u] - potential_[ed.to];
+                    if (nd < dist_[ed.to]) {
+                        dist_[ed.to] = nd;
+                        if (buckets_.size() <= static_cast<std::size_t>(nd)) buckets_.resize(nd + 1);
+                        buckets_[nd].push_back(ed.to);
+                    }
+                }
+            }
+            if (dist_[sink] <= static_cast<long long>(d)) break; // nothing shorter than the sink matters
+        }
+        if (dist_[sink] >= INF_DIST) break;
+
+        // nodes not settled before the sink get dist(sink): keeps reduced costs >= 0
+        for (int v = 0; v < numNodes; ++v) {
+            potential_[v] += std::min(dist_[v], dist_[sink]);
+        }
+
+        for (int v = 0; v < numNodes; ++v) curArc[v] = head_[v];
+        int pushed;
+        while ((pushed = augment(source, INT_MAX)) > 0) {
+            flow += pushed;
+        }
+    }
+    return flow;
+}
+
+void OptFlowScheduler::runBatch(std::vector<Job*>& jobs,
+                                std::vector<Server*>& servers,
+                                int currentTime,
+                                Simulation *sim)
+{
+    // S1. waiting jobs and server id -> index
+    active_.clear();
+    for (Job* j : jobs) {
+        if (!j) continue;
+        if (!j->isWaiting()) continue;
+        if (j->reportedDemand() <= 0) continue;
+        active_.push_back(j);
+    }
+    if (active_.empty() || servers.empty()) return;
+
+    int maxId = 0;
+    for (Server* s : servers) {
+        if (s) maxId = std::max(maxId, s->id());
+    }
+    serverIndexById_.assign(maxId + 1, -1);
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        if (servers[si] && servers[si]->freeCapacity() > 0) {
+            serverIndexById_[servers[si]->id()] = static_cast<int>(si);
+        }
+    }
+
+    // S2. build the network: 0 = source, 1 = sink, servers, then jobs
+    int numServers = static_cast<int>(servers.size());
+    int numNodes = 2 + numServers + static_cast<int>(active_.size());
+    edges_.clear();
+    edgeNext_.clear();
+    head_.assign(numNodes, -1);
+
+    for (int si = 0; si < numServers; ++si) {
+        if (servers[si] && servers[si]->freeCapacity() > 0) {
+            addEdge(2 + si, SINK, servers[si]->freeCapacity(), 0);
+        }
+    }
+
+    jobFirstEdge_.assign(active_.size(), 0);
+    jobNumEdges_.assign(active_.size(), 0);
+    for (std::size_t i = 0; i < active_.size(); ++i) {
+        Job* job = active_[i];
+        int jobNode = 2 + numServers + static_cast<int>(i);
+        int d = job->reportedDemand();
+
+        jobFirstEdge_[i] = static_cast<int>(edges_.size());
+        const int* prefs = job->preferences();
+        for (int k = 0; k < job->numPreferences(); ++k) {
+            int sid = prefs[k];
+            if (sid < 0 || sid > maxId) continue;
+            int si = serverIndexById_[sid];
+            // an integral placement only uses servers the job fits on
+            if (si < 0 || servers[si]->freeCapacity() < d) continue;
+            addEdge(jobNode, 2 + si, d, k);
+            ++jobNumEdges_[i];
+        }
+        if (jobNumEdges_[i] > 0) {
+            addEdge(SOURCE, jobNode, d, 0);
+        }
+    }
+
+    // S3. fractional optimum
+    int flow = minCostMaxFlow(SOURCE, SINK, numNodes);
+    lpBound_ += flow;
+    ++batches_;
+
+    auto place = [&](Job* job, Server* s) {
+        if (s->accept(job)) {
+            job->markRunning(currentTime);
+            placed_ += job->reportedDemand();
+            if (sim) sim->logJobStart(job, s, currentTime);
+        } else {
+            job->markFailed(currentTime);
+        }
+    };
+
+    // S4. rounding, part 1: jobs routed whole to one server
+    std::vector<std::pair<int, std::size_t>> rest; // (-routed flow, job index)
+    for (std::size_t i = 0; i < active_.size(); ++i) {
+        Job* job = active_[i];
+        int d = job->reportedDemand();
+        int routed = 0;
+        int wholeServer = -1;
+        for (int k = 0; k < jobNumEdges_[i]; ++k) {
+            const Edge& e = edges_[jobFirstEdge_[i] + 2 * k];
+            int f = d - e.cap;
+            routed += f;
+            if (f == d) wholeServer = e.to - 2;
+        }
+        if (wholeServer >= 0 && servers[wholeServer]->freeCapacity() >= d) {
+            place(job, servers[wholeServer]);
+        } else if (jobNumEdges_[i] > 0) {
+            rest.emplace_back(-routed, i);
+        }
+    }
+
+    // S5. rounding, part 2: split jobs first (largest routed share), then the rest, best-fit
+    std::stable_sort(rest.begin(), rest.end(),
+                     [](const std::pair<int, std::size_t>& a,
+                        const std::pair<int, std::size_t>& b) {
+                         return a.first < b.first;
+                     });
+    for (const auto& r : rest) {
+        std::size_t i = r.second;
+        Job* job = active_[i];
+        int d = job->reportedDemand();
+
+        Server* best = nullptr;
+        int bestSlack = INT_MAX;
+        for (int k = 0; k < jobNumEdges_[i]; ++k) {
+            Server* s = servers[edges_[jobFirstEdge_[i] + 2 * k].to - 2];
+            int slack = s->freeCapacity() - d;
+            if (slack >= 0 && slack < bestSlack) {
+                bestSlack = slack;
+                best = s;
+            }
+        }
+        if (best) place(job, best);
+    }
+}
+
+void OptFlowScheduler::resetStats() {
+    lpBound_ = 0.0;
+    placed_  = 0.0;
+    batches_ = 0;
+}
+
+void OptFlowScheduler::printStats() const {
+    std::cout << "LP bound demand: " << lpBound_
+              << ", placed demand: " << placed_;
+    if (lpBound_ > 0.0) {
+        std::cout << " (" << (100.0 * placed_ / lpBound_) << "% of bound)";
+    }
+    std::cout << " over " << batches_ << " batches\n";
+}
+
+MemUsage OptFlowScheduler::scratchUsage() const {
+    MemUsage u;
+    u.addVector(edges_);
+    u.addVector(edgeNext_);
+    u.addVector(head_);
+    u.addVector(potential_);
+    u.addVector(dist_);
+    u.addVector(buckets_);
+    u.addVector(active_);
+    u.addVector(serverIndexById_);
+    u.addVector(jobFirstEdge_);
+    u.addVector(jobNumEdges_);
+    return u;
+}
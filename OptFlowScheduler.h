@@ -0,0 +1,63 @@
+#ifndef OPT_FLOW_SCHEDULER_H
+#define OPT_FLOW_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "Simulation.h"
+
+#include <vector>
+
+// Optimal-placement baseline via min-cost max-flow
+// - Network: source -> job (cap = reportedDemand) -> server on the job's
+//   list that could hold it (cost = preference rank) -> sink (cap = freeCapacity)
+// - Max flow = LP relaxation of "place as much demand as possible"
+//   (jobs may split), min cost picks the best-ranked servers among those
+//   flows; this is an upper bound for any integral placement in the batch
+// - Rounding: jobs routed whole to one server go there, split and unrouted
+//   jobs are then best-fit into what is left (preference list only)
+// - Unplaced jobs stay Waiting for the next batch (like BaseScheduler)
+class OptFlowScheduler : public Scheduler {
+public:
+    OptFlowScheduler() = default;
+    ~OptFlowScheduler() override = default;
+
+    void runBatch(std::vector<Job*>& jobs,
+                  std::vector<Server*>& servers,
+                  int currentTime,
+                  Simulation *sim) override;
+
+    void resetStats() override;
+    void printStats() const override;
+    MemUsage scratchUsage() const override;
+
+    double lpBoundDemand() const { return lpBound_; }
+    double placedDemand() const { return placed_; }
+
+private:
+    struct Edge {
+        int to;
+        int cap;
+        int cost;
+    };
+
+    // scratch graph, reused across batches
+    std::vector<Edge> edges_;
+    std::vector<int> edgeNext_;
+    std::vector<int> head_;
+    std::vector<long long> potential_;
+    std::vector<long long> dist_;
+    std::vector<std::vector<int>> buckets_; // Dial's queue, index = distance
+
+    std::vector<Job*> active_;
+    std::vector<int> serverIndexById_; // server id -> index in servers, -1 = full
+    std::vector<int> jobFirstEdge_; // first job->server edge of each active job
+    std::vector<int> jobNumEdges_;
+
+    double lpBound_ = 0.0;
+    double placed_  = 0.0;
+    int batches_ = 0;
+
+    void addEdge(int from, int to, int cap, int cost);
+    int minCostMaxFlow(int source, int sink, int numNodes);
+};
+
+#endif // OPT_FLOW_SCHEDULER_H
@@ -0,0 +1,326 @@
+#include "Replicated.h"
+#include "Config.h"
+#include "DataGenerator.h"
+#include "Job.h"
+#include "Server.h"
+#include "Scheduler.h"
+#include "SchedulerFactory.h"
+#include "Arena.h"
+#include "Stats.h"
+#include "ResultWriter.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <iostream>
+#include <memory>
+
+static const int NO_FINISH = INT_MAX;
+
+// a job started at s with duration d is removed at the first tick t >= s + d
+void ReplicatedSimulation::refresh(int k, const Server* server) {
+    int next = NO_FINISH;
+    for (const Job* job : server->assignedJobs()) {
+        if (job && job->isRunning()) next = std::min(next, job->startTime() + job->duration());
+    }
+    used_[k]       = server->usedCapacity();
+    nextFinish_[k] = next;
+    assigned_[k]   = static_cast<int>(server->assignedJobs().size());
+}
+
+std::vector<Metrics> ReplicatedSimulation::run(const std::vector<Scheduler*>& schedulers,
+                                               std::vector<std::vector<Job*>>& jobs,
+                                               std::vector<std::vector<Server*>>& servers,
+                                               int batchSize)
+{
+    const int R = static_cast<int>(schedulers.size());
+    std::vector<Metrics> metrics(R);
+    if (R == 0) return metrics;
+    const int S = static_cast<int>(servers[0].size());
+
+    // S1. per-replica state; like Simulation::run, a replica without jobs or
+    //     servers only reports totalJobs
+    std::vector<std::vector<Job*>> order(R);
+    std::vector<std::size_t> cursor(R, 0);
+    std::vector<std::vector<Job*>> waiting(R);
+    std::vector<BatchController> batchers(R, BatchController(batchPolicy_, batchSize));
+    std::vector<double> totalCap(R, 0.0), utilizationSum(R, 0.0);
+    std::vector<char> live(R, 0);
+    std::vector<int> arrived(R, 0), freed(R, 0), usedSum(R, 0);
+    bool timeBatches = batchPolicy_.adaptive && batchPolicy_.costTargetUs > 0.0;
+
+    for (int r = 0; r < R; ++r) {
+        metrics[r].totalJobs = static_cast<int>(jobs[r].size());
+        live[r] = !jobs[r].empty() && !servers[r].empty();
+        for (Job* j : jobs[r]) {
+            if (j) order[r].push_back(j);
+        }
+        // stable: jobs arriving in the same tick keep their input order
+        std::stable_sort(order[r].begin(), order[r].end(), [](const Job* a, const Job* b) {
+            return a->arrivalTime() < b->arrivalTime();
+        });
+        for (Server* s : servers[r]) {
+            if (s) totalCap[r] += s->capacity();
+        }
+    }
+
+    used_.assign(static_cast<std::size_t>(S) * R, 0);
+    nextFinish_.assign(static_cast<std::size_t>(S) * R, NO_FINISH);
+    assigned_.assign(static_cast<std::size_t>(S) * R, 0);
+    for (int s = 0; s < S; ++s) {
+        for (int r = 0; r < R; ++r) {
+            if (servers[r][s]) refresh(s * R + r, servers[r][s]);
+        }
+    }
+
+    int timeSteps = 0;
+    for (int t = 0; t <= timeLimit_; ++t) {
+        // S2. arrivals, from each replica's cursor
+        for (int r = 0; r < R; ++r) {
+            arrived[r] = 0;
+            freed[r]   = 0;
+            if (!live[r]) continue;
+            std::vector<Job*>& ord = order[r];
+            std::size_t& c = cursor[r];
+            for (; c < ord.size() && ord[c]->arrivalTime() <= t; ++c) {
+                if (ord[c]->arrivalTime() < t) continue; // before tick 0, never arrives
+                waiting[r].push_back(ord[c]);
+                ++arrived[r];
+            }
+        }
+
+        // S3. finish check over every lane at once, then visit only the servers
+        //     with a job due
+        const int* nf = nextFinish_.data();
+        int due = 0;
+        for (int k = 0; k < S * R; ++k) {
+            due |= (nf[k] <= t);
+        }
+        if (due) {
+            for (int k = 0; k < S * R; ++k) {
+                if (nf[k] > t) continue;
+                int r = k % R;
+                Server* server = servers[r][k / R];
+                freed[r] += server->removeFinishedJobs(t, nullptr);
+                refresh(k, server);
+            }
+        }
+
+        // S4. batches, one replica at a time
+        for (int r = 0; r < R; ++r) {
+            if (!live[r]) continue;
+            BatchController& batcher = batchers[r];
+            batcher.onArrivals(arrived[r], t);
+            batcher.onCapacityFreed(freed[r]);
+            if (!batcher.due(t)) continue;
+            if (!batcher.dirty()) {
+                batcher.onSkip();
+                continue;
+            }
+
+            std::vector<Job*>& queue = waiting[r];
+            int queueIn = static_cast<int>(queue.size());
+            auto t0 = std::chrono::steady_clock::now();
+            schedulers[r]->runBatch(queue, servers[r], t, nullptr);
+            double costUs = 0.0;
+            if (timeBatches) {
+                costUs = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - t0).count();
+            }
+
+            queue.erase(std::remove_if(queue.begin(), queue.end(),
+                                       [](Job* j) { return !j || !j->isWaiting(); }),
+                        queue.end());
+            batcher.onBatch(t, queueIn, static_cast<int>(queue.size()), costUs);
+            if (schedulers[r]->hasCarriedWork()) batcher.onCarry();
+
+            // placements only append to assignedJobs, read the new tail
+            for (int s = 0; s < S; ++s) {
+                Server* server = servers[r][s];
+                if (!server) continue;
+                int k = s * R + r;
+                const auto& list = server->assignedJobs();
+                if (static_cast<int>(list.size()) == assigned_[k]) continue;
+                for (std::size_t i = assigned_[k]; i < list.size(); ++i) {
+                    const Job* job = list[i];
+                    if (job && job->isRunning()) {
+                        nextFinish_[k] = std::min(nextFinish_[k], job->startTime() + job->duration());
+                    }
+                }
+                assigned_[k] = static_cast<int>(list.size());
+                used_[k]     = server->usedCapacity();
+            }
+        }
+
+        // S5. utilization, one row of lanes per server
+        std::fill(usedSum.begin(), usedSum.end(), 0);
+        for (int s = 0; s < S; ++s) {
+            const int* row = used_.data() + static_cast<std::size_t>(s) * R;
+            for (int r = 0; r < R; ++r) {
+                usedSum[r] += row[r];
+            }
+        }
+        for (int r = 0; r < R; ++r) {
+            if (totalCap[r] > 0.0) utilizationSum[r] += usedSum[r] / totalCap[r];
+        }
+        ++timeSteps;
+    }
+
+    for (int r = 0; r < R; ++r) {
+        if (!live[r]) continue;
+        stats_.collectMetrics(jobs[r], metrics[r]);
+        if (timeSteps > 0) metrics[r].avgUtilization = utilizationSum[r] / timeSteps;
+        metrics[r].numBatches     = batchers[r].batches();
+        metrics[r].skippedBatches = batchers[r].skipped();
+        metrics[r].maxBatchDelay  = batchers[r].maxObservedDelay();
+    }
+    return metrics;
+}
+
+// the fields Simulation::run fills in without workflows
+static bool sameMetrics(const Metrics& a, const Metrics& b) {
+    return a.totalJobs == b.totalJobs && a.finishedJobs == b.finishedJobs &&
+           a.avgCompletionTime == b.avgCompletionTime && a.avgWaitingTime == b.avgWaitingTime &&
+           a.avgUtilization == b.avgUtilization && a.waitingP95 == b.waitingP95 &&
+           a.maxWaitingTime == b.maxWaitingTime && a.numBatches == b.numBatches &&
+           a.skippedBatches == b.skippedBatches && a.maxBatchDelay == b.maxBatchDelay &&
+           a.deadlineMisses == b.deadlineMisses && a.jainIndex == b.jainIndex;
+}
+
+int runLockstepMode(const RunConfig& rc, unsigned int baseSeed,
+                    const std::string& configName,
+                    const std::string& resultsFile,
+                    const std::string& summaryFile) {
+    const LockstepConfig& cfg = rc.lockstep;
+    if (rc.gen.workflowSize > 1) {
+        std::cerr << "mode=lockstep does not support workflowSize > 1\n";
+        return 1;
+    }
+    int lanes = std::max(cfg.lanes, 1);
+
+    // S1. scenarios, one scheduler per lane (+ one for the sequential check)
+    struct LockstepScenario {
+        std::string name;
+        std::string type;
+        bool strategic = false;
+        std::vector<std::unique_ptr<Scheduler>> lanes;
+        std::unique_ptr<Scheduler> reference;
+    };
+    std::vector<LockstepScenario> scenarios;
+    for (const std::string& name : rc.schedulers) {
+        if (!makeScheduler(name, rc.daBudget, rc.daScores)) {
+            std::cerr << "Unknown scheduler '" << name << "', skipped.\n";
+            continue;
+        }
+        for (int strategic = 0; strategic <= 1; ++strategic) {
+            LockstepScenario sc;
+            sc.name = name;
+            sc.strategic = (strategic == 1);
+            sc.type = name + (sc.strategic ? "_strat" : "_truth");
+            for (int r = 0; r < lanes; ++r) sc.lanes.push_back(makeScheduler(name, rc.daBudget, rc.daScores));
+            if (cfg.check) sc.reference = makeScheduler(name, rc.daBudget, rc.daScores);
+            scenarios.push_back(std::move(sc));
+        }
+    }
+
+    std::cout << "=== Lockstep: " << rc.numSeeds << " seeds x " << scenarios.size()
+              << " scenarios, " << lanes << " lanes ===\n";
+
+    ReplicatedSimulation lockstep(rc.timeLimit);
+    lockstep.setBatchPolicy(rc.batch);
+    Simulation sim(rc.timeLimit);
+    sim.setBatchPolicy(rc.batch);
+    sim.setRecordSampling(0);
+
+    std::vector<Arena> arenas(lanes);
+    std::vector<GeneratorConfig> gens(lanes, rc.gen);
+    std::vector<std::vector<Job*>> trueJobs(lanes);
+    std::vector<std::vector<Job*>> jobs;
+    std::vector<std::vector<Server*>> servers;
+    std::vector<std::vector<Metrics>> results(scenarios.size());
+    SeedAggregator agg;
+
+    using Clock = std::chrono::steady_clock;
+    double lockstepSec = 0.0, sequentialSec = 0.0;
+    long long mismatches = 0;
+
+    for (int first = 0; first < rc.numSeeds; first += lanes) {
+        TRACE_SCOPE("lockstep group", first);
+        int R = std::min(lanes, rc.numSeeds - first);
+        jobs.assign(R, {});
+        servers.assign(R, {});
+
+        // S2. ground truth of seeds first .. first+R-1
+        for (int r = 0; r < R; ++r) {
+            arenas[r].reset();
+            gens[r].seed = baseSeed + first + r;
+            DataGenerator(gens[r]).generateTrueJobs(trueJobs[r], arenas[r]);
+        }
+        auto makeCopies = [&](const LockstepScenario& sc) {
+            for (int r = 0; r < R; ++r) {
+                DataGenerator gen(gens[r]);
+                gen.generateServers(servers[r], arenas[r]);
+                if (sc.strategic) gen.makeStrategicCopy(trueJobs[r], jobs[r], arenas[r]);
+                else gen.makeTruthfulCopy(trueJobs[r], jobs[r], arenas[r]);
+            }
+        };
+
+        // S3. each scenario on all R seeds at once, optionally again seed by seed
+        for (std::size_t i = 0; i < scenarios.size(); ++i) {
+            LockstepScenario& sc = scenarios[i];
+            std::vector<Scheduler*> active;
+            for (int r = 0; r < R; ++r) active.push_back(sc.lanes[r].get());
+
+            makeCopies(sc);
+            Clock::time_point t0 = Clock::now();
+            results[i] = lockstep.run(active, jobs, servers, rc.batchSize);
+            lockstepSec += std::chrono::duration<double>(Clock::now() - t0).count();
+
+            if (!cfg.check) continue;
+            makeCopies(sc);
+            for (int r = 0; r < R; ++r) {
+                t0 = Clock::now();
+                Metrics m = sim.run(*sc.reference, jobs[r], servers[r], rc.batchSize, nullptr);
+                sequentialSec += std::chrono::duration<double>(Clock::now() - t0).count();
+                if (sameMetrics(m, results[i][r])) continue;
+                if (mismatches++ == 0) {
+                    std::cerr << "Lockstep differs from Simulation: seed " << gens[r].seed
+                              << ", " << sc.type << "\n";
+                }
+            }
+        }
+
+        // S4. per-seed rows and summary, in seed order
+        for (int r = 0; r < R; ++r) {
+            for (std::size_t i = 0; i < scenarios.size(); ++i) {
+                const LockstepScenario& sc = scenarios[i];
+                agg.add(sc.type, results[i][r]);
+                for (std::size_t b = 0; b < scenarios.size(); ++b) {
+                    const LockstepScenario& base = scenarios[b];
+                    if (sc.name == rc.pairedBaseline || base.name != rc.pairedBaseline ||
+                        base.strategic != sc.strategic) continue;
+                    agg.addPaired(sc.type, results[i][r], base.type, results[b][r]);
+                }
+                if (rc.perSeedRows) {
+                    ResultWriter::writeCSV(resultsFile, configName, sc.type, gens[r].seed, results[i][r]);
+                }
+            }
+        }
+    }
+
+    long long runs = static_cast<long long>(rc.numSeeds) * static_cast<long long>(scenarios.size());
+    std::cout << "Lockstep: " << lockstepSec << " s ("
+              << (lockstepSec > 0 ? runs / lockstepSec : 0.0) << " seed-runs/s)\n";
+    if (cfg.check) {
+        std::cout << "Sequential: " << sequentialSec << " s ("
+                  << (sequentialSec > 0 ? runs / sequentialSec : 0.0) << " seed-runs/s), speedup "
+                  << (lockstepSec > 0 ? sequentialSec / lockstepSec : 0.0) << "x, "
+                  << mismatches << " mismatching runs\n";
+    }
+    std::cout << "===== Summary over " << rc.numSeeds << " seeds (mean +- 95% CI) =====\n";
+    agg.print();
+    ResultWriter::writeSummaryCSV(summaryFile, configName, agg);
+
+    return (mismatches > 0) ? 1 : 0;
+}
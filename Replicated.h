@@ -0,0 +1,66 @@
+#ifndef REPLICATED_H
+#define REPLICATED_H
+
+#include <string>
+#include <vector>
+
+#include "BatchController.h"
+#include "Metrics.h"
+#include "Simulation.h"
+
+class Job;
+class Server;
+class Scheduler;
+struct RunConfig;
+
+struct LockstepConfig {
+    int lanes  = 8;     // seeds advanced in lockstep
+    bool check = false; // also run every seed through Simulation and compare
+};
+
+// ReplicatedSimulation：R independent replicas of one scenario (one per seed)
+// advanced tick by tick in lockstep
+// - per-server state is kept as [server][replica] arrays: used capacity,
+//   assigned-job count and the earliest finish among the server's jobs, so the
+//   finish check and the utilization sum are flat loops over contiguous lanes
+//   (vectorized by the compiler) and only servers with a job due are visited
+// - arrivals come from a per-replica cursor over jobs sorted by arrival time
+// - scheduling stays scalar, one Scheduler per replica
+// - each replica's Metrics equal Simulation::run on the same input; no job
+//   records, occupancy, replay trace or workflow DAGs
+class ReplicatedSimulation {
+public:
+    explicit ReplicatedSimulation(int timeLimit)
+        : stats_(timeLimit), timeLimit_(timeLimit) {}
+
+    void setBatchPolicy(const BatchPolicy& policy) { batchPolicy_ = policy; }
+
+    // jobs[r] / servers[r] / schedulers[r] belong to replica r, every replica
+    // needs the same number of servers
+    std::vector<Metrics> run(const std::vector<Scheduler*>& schedulers,
+                             std::vector<std::vector<Job*>>& jobs,
+                             std::vector<std::vector<Server*>>& servers,
+                             int batchSize);
+
+private:
+    Simulation stats_; // collectMetrics only
+    int timeLimit_;
+    BatchPolicy batchPolicy_;
+
+    // [server][replica], index s * R + r
+    std::vector<int> used_;
+    std::vector<int> nextFinish_;
+    std::vector<int> assigned_;
+
+    // re-read server (s, r) after it changed
+    void refresh(int k, const Server* server);
+};
+
+// mode=lockstep: numSeeds seeds of every scenario in groups of cfg.lanes, per-seed
+// rows + cross-seed summary as in the normal mode, plus lockstep throughput
+int runLockstepMode(const RunConfig& rc, unsigned int baseSeed,
+                    const std::string& configName,
+                    const std::string& resultsFile,
+                    const std::string& summaryFile);
+
+#endif // REPLICATED_H
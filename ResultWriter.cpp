@@ -28,4 +28,197 @@ void writeCSV(const std::string& filename,
          << m.avgUtilization << "\n";
 }
 
+void writeDeadlineCSV(const std::string& filename,
+                      const std::string& configName,
+                      const std::string& schedulerType,
+                      unsigned int seed,
+                      const Metrics& m)
+{
+    bool newFile = !std::filesystem::exists(filename);
+
+    std::ofstream fout(filename, std::ios::app);
+
+    if (newFile) {
+        fout << "seed,config,type,deadlineJobs,misses,missRate,latenessP50,latenessP95,latenessP99\n";
+    }
+
+    fout << seed << ","
+         << configName << ","
+         << schedulerType << ","
+         << m.deadlineJobs << ","
+         << m.deadlineMisses << ","
+         << m.missRate << ","
+         << m.latenessP50 << ","
+         << m.latenessP95 << ","
+         << m.latenessP99 << "\n";
+}
+
+void writeWorkflowCSV(const std::string& filename,
+                      const std::string& configName,
+                      const std::string& schedulerType,
+                      unsigned int seed,
+                      const Metrics& m)
+{
+    bool newFile = !std::filesystem::exists(filename);
+
+    std::ofstream fout(filename, std::ios::app);
+
+    if (newFile) {
+        fout << "seed,config,type,workflows,done,makespanAvg,stretchMean,stretchP95\n";
+    }
+
+    fout << seed << ","
+         << configName << ","
+         << schedulerType << ","
+         << m.workflows << ","
+         << m.workflowsDone << ","
+         << m.makespanAvg << ","
+         << m.stretchMean << ","
+         << m.stretchP95 << "\n";
+}
+
+void writeTenantCSV(const std::string& filename,
+                    const std::string& configName,
+                    const std::string& schedulerType,
+                    unsigned int seed,
+                    const Metrics& m)
+{
+    bool newFile = !std::filesystem::exists(filename);
+
+    std::ofstream fout(filename, std::ios::app);
+
+    if (newFile) {
+        fout << "seed,config,type,tenant,jobs,finished,usage,requested,share,served,jain\n";
+    }
+
+    for (std::size_t t = 0; t < m.tenants.size(); ++t) {
+        const TenantMetrics& tm = m.tenants[t];
+        fout << seed << ","
+             << configName << ","
+             << schedulerType << ","
+             << t << ","
+             << tm.jobs << ","
+             << tm.finished << ","
+             << tm.usage << ","
+             << tm.requested << ","
+             << tm.share << ","
+             << tm.served << ","
+             << m.jainIndex << "\n";
+    }
+}
+
+void writePaymentsCSV(const std::string& filename,
+                      const std::string& configName,
+                      const std::string& schedulerType,
+                      unsigned int seed,
+                      const std::vector<PaymentRecord>& payments)
+{
+    bool newFile = !std::filesystem::exists(filename);
+
+    std::ofstream fout(filename, std::ios::app);
+
+    if (newFile) {
+        fout << "seed,config,type,time,jobId,serverId,trueDemand,reportedDemand,unitPrice,payment\n";
+    }
+
+    for (const PaymentRecord& r : payments) {
+        fout << seed << ","
+             << configName << ","
+             << schedulerType << ","
+             << r.time << ","
+             << r.jobId << ","
+             << r.serverId << ","
+             << r.trueDemand << ","
+             << r.reportedDemand << ","
+             << r.unitPrice << ","
+             << r.payment << "\n";
+    }
+}
+
+void writeCounterfactualCSV(const std::string& filename,
+                            const std::string& configName,
+                            const std::string& schedulerType,
+                            unsigned int seed,
+                            const DeviationSummary& d)
+{
+    bool newFile = !std::filesystem::exists(filename);
+
+    std::ofstream fout(filename, std::ios::app);
+
+    if (newFile) {
+        fout << "seed,config,type,factor,jobs,improved,worsened,avgGain,maxGain\n";
+    }
+
+    fout << seed << ","
+         << configName << ","
+         << schedulerType << ","
+         << d.factor << ","
+         << d.jobs << ","
+         << d.improved << ","
+         << d.worsened << ","
+         << d.avgGain << ","
+         << d.maxGain << "\n";
+}
+
+void writeSummaryCSV(const std::string& filename,
+                     const std::string& configName,
+                     const SeedAggregator& agg)
+{
+    bool newFile = !std::filesystem::exists(filename);
+
+    std::ofstream fout(filename, std::ios::app);
+
+    if (newFile) {
+        fout << "config,type,metric,n,mean,stddev,ciLow,ciHigh\n";
+    }
+
+    auto row = [&](const std::string& type, const char* metric, const RunningStat& s) {
+        fout << configName << ","
+             << type << ","
+             << metric << ","
+             << s.count() << ","
+             << s.mean() << ","
+             << s.stddev() << ","
+             << s.mean() - s.ciHalfWidth() << ","
+             << s.mean() + s.ciHalfWidth() << "\n";
+    };
+
+    for (const SeedAggregator::Row& r : agg.rows()) {
+        row(r.type, "finishedJobs",  r.finishedJobs);
+        row(r.type, "avgCompletion", r.avgCompletionTime);
+        row(r.type, "avgWaiting",    r.avgWaitingTime);
+        row(r.type, "util",          r.avgUtilization);
+    }
+}
+
+void writeMemoryCSV(const std::string& filename,
+                    const std::string& configName,
+                    unsigned int seed,
+                    const MemReport& mem)
+{
+    bool newFile = !std::filesystem::exists(filename);
+
+    std::ofstream fout(filename, std::ios::app);
+
+    if (newFile) {
+        fout << "seed,config,phase,rssBytes,peakRssBytes";
+        for (int s = 0; s < MEM_NUM; ++s) {
+            fout << "," << memSubsystemName(s) << "Bytes," << memSubsystemName(s) << "Allocs";
+        }
+        fout << "\n";
+    }
+
+    for (const MemReport::Phase& p : mem.phases()) {
+        fout << seed << ","
+             << configName << ","
+             << p.name << ","
+             << p.rss << ","
+             << p.peakRss;
+        for (int s = 0; s < MEM_NUM; ++s) {
+            fout << "," << p.usage[s].bytes << "," << p.usage[s].allocs;
+        }
+        fout << "\n";
+    }
+}
+
 }
@@ -3,6 +3,10 @@
 
 #include <string>
 #include "Metrics.h"
+#include "Counterfactual.h"
+#include "Stats.h"
+#include "MemStats.h"
+#include "AuctionScheduler.h"
 
 namespace ResultWriter {
     
@@ -12,6 +16,52 @@ namespace ResultWriter {
                   unsigned int seed,
                   const Metrics& m);
 
+    // deadlines on: miss rate + lateness percentiles per (seed, scenario)
+    void writeDeadlineCSV(const std::string& filename,
+                          const std::string& configName,
+                          const std::string& schedulerType,
+                          unsigned int seed,
+                          const Metrics& m);
+
+    // workflows on: makespan + critical-path stretch per (seed, scenario)
+    void writeWorkflowCSV(const std::string& filename,
+                          const std::string& configName,
+                          const std::string& schedulerType,
+                          unsigned int seed,
+                          const Metrics& m);
+
+    // numTenants > 1: one row per (seed, scenario, tenant) + Jain's index
+    void writeTenantCSV(const std::string& filename,
+                        const std::string& configName,
+                        const std::string& schedulerType,
+                        unsigned int seed,
+                        const Metrics& m);
+
+    // auction winners: one row per (seed, scenario, placed job)
+    void writePaymentsCSV(const std::string& filename,
+                          const std::string& configName,
+                          const std::string& schedulerType,
+                          unsigned int seed,
+                          const std::vector<PaymentRecord>& payments);
+
+    // one row per (run, deviation factor)
+    void writeCounterfactualCSV(const std::string& filename,
+                                const std::string& configName,
+                                const std::string& schedulerType,
+                                unsigned int seed,
+                                const DeviationSummary& d);
+
+    // cross-seed summary: one row per (type, metric) with a 95% CI
+    void writeSummaryCSV(const std::string& filename,
+                         const std::string& configName,
+                         const SeedAggregator& agg);
+
+    // memStats=1: one row per (seed, phase), bytes + allocations per subsystem
+    void writeMemoryCSV(const std::string& filename,
+                        const std::string& configName,
+                        unsigned int seed,
+                        const MemReport& mem);
+
 }
 
 #endif
@@ -2,6 +2,7 @@
 #define SCHEDULER_H
 
 #include "Simulation.h"
+#include "MemStats.h"
 
 #include <vector>
 
@@ -24,6 +25,21 @@ public:
         int currentTime,
         Simulation *sim
     ) = 0;
+
+    // optional scheduler-specific statistics, accumulated over runBatch calls
+    virtual void resetStats() {}
+    virtual void printStats() const {}
+
+    // true when the last runBatch stopped early and left work for the next
+    // batch, which then has to run even if nothing arrived or finished
+    virtual bool hasCarriedWork() const { return false; }
+
+    // false when a rerun from a ReplayTrace can't reproduce the run, e.g. state
+    // carried between batches or wall-clock dependent cuts (see Counterfactual.h)
+    virtual bool replayable() const { return true; }
+
+    // scratch kept between batches, for memStats=1
+    virtual MemUsage scratchUsage() const { return MemUsage(); }
 };
 
 #endif // SCHEDULER_H
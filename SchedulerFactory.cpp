@@ -0,0 +1,74 @@
+#include "SchedulerFactory.h"
+#include "BaseScheduler.h"
+#include "DAScheduler.h"
+#include "OptFlowScheduler.h"
+#include "EDFScheduler.h"
+#include "BackfillScheduler.h"
+#include "DRFScheduler.h"
+#include "AuctionScheduler.h"
+#include "TopologyScheduler.h"
+
+#include <iostream>
+
+std::unique_ptr<Scheduler> makeScheduler(const std::string& name,
+                                         const DABudget& daBudget,
+                                         std::shared_ptr<const PriorityRule> daScores) {
+    if (name == "base") return std::unique_ptr<Scheduler>(new BaseScheduler());
+    if (name == "da")   return std::unique_ptr<Scheduler>(new DAScheduler());
+    if (name == "opt")  return std::unique_ptr<Scheduler>(new OptFlowScheduler());
+    if (name == "edf")  return std::unique_ptr<Scheduler>(new EDFScheduler());
+    if (name == "easy") return std::unique_ptr<Scheduler>(new BackfillScheduler(BackfillScheduler::Mode::Easy));
+    if (name == "cbf")  return std::unique_ptr<Scheduler>(new BackfillScheduler(BackfillScheduler::Mode::Conservative));
+    if (name == "drf")  return std::unique_ptr<Scheduler>(new DRFScheduler());
+    if (name == "auction") return std::unique_ptr<Scheduler>(new AuctionScheduler());
+    if (name == "topo") return std::unique_ptr<Scheduler>(new TopologyScheduler());
+    if (name == "dafifo") {
+        DAScheduler* da = new DAScheduler();
+        da->setPriority(std::make_shared<ArrivalPriority>());
+        return std::unique_ptr<Scheduler>(da);
+    }
+    if (name == "daknap") {
+        return std::unique_ptr<Scheduler>(new DAScheduler(DAScheduler::Engine::Rounds,
+                                                          DAScheduler::Acceptance::Knapsack));
+    }
+    if (name == "dabudget") {
+        // the rounds engine, so daBudgetRounds means proposal rounds
+        DAScheduler* da = new DAScheduler(DAScheduler::Engine::Rounds);
+        da->setBudget(daBudget);
+        return std::unique_ptr<Scheduler>(da);
+    }
+    if (name == "dascore") {
+        if (!daScores) return nullptr;
+        DAScheduler* da = new DAScheduler();
+        da->setPriority(std::move(daScores));
+        return std::unique_ptr<Scheduler>(da);
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const PriorityRule> loadDAScores(const std::string& path) {
+    auto table = std::make_shared<ScoreTablePriority>();
+    std::string error;
+    if (!table->loadCSV(path, &error)) {
+        std::cerr << "daScoreFile: " << error << "\n";
+        return nullptr;
+    }
+    return table;
+}
+
+std::string schedulerLabel(const std::string& name) {
+    if (name == "base") return "Base";
+    if (name == "da")   return "DA";
+    if (name == "opt")  return "Opt";
+    if (name == "edf")  return "EDF";
+    if (name == "easy") return "EASY-Backfill";
+    if (name == "cbf")  return "Cons-Backfill";
+    if (name == "drf")  return "DRF";
+    if (name == "auction") return "Auction";
+    if (name == "topo") return "Topology";
+    if (name == "dafifo") return "DA-FIFO";
+    if (name == "daknap") return "DA-Knapsack";
+    if (name == "dabudget") return "DA-Budget";
+    if (name == "dascore") return "DA-Score";
+    return name;
+}
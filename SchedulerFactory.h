@@ -0,0 +1,36 @@
+#ifndef SCHEDULER_FACTORY_H
+#define SCHEDULER_FACTORY_H
+
+#include <memory>
+#include <string>
+
+#include "Scheduler.h"
+#include "DAScheduler.h"
+
+// short config names -> schedulers
+//   "base" : BaseScheduler (best-fit)
+//   "da"   : DAScheduler
+//   "opt"  : OptFlowScheduler (min-cost-flow upper-bound baseline)
+//   "edf"  : EDFScheduler (earliest deadline first, best-fit)
+//   "easy" : BackfillScheduler, EASY (reservation for the first blocked job)
+//   "cbf"  : BackfillScheduler, conservative (reservation for every blocked job)
+//   "drf"  : DRFScheduler (fair share across tenants, best-fit)
+//   "auction" : AuctionScheduler (ascending auction with uniform unit prices)
+//   "topo" : TopologyScheduler (locality-aware best-fit down the rack / pod tree)
+//   "dafifo" : DAScheduler, servers prefer earlier arrivals
+//   "daknap" : DAScheduler with knapsack server acceptance
+//   "dabudget" : DAScheduler, rounds engine cut off at daBudget per batch (anytime DA)
+//   "dascore" : DAScheduler, servers rank by daScores (see loadDAScores)
+// returns nullptr for unknown names, and for "dascore" without daScores
+std::unique_ptr<Scheduler> makeScheduler(const std::string& name,
+                                         const DABudget& daBudget = DABudget(),
+                                         std::shared_ptr<const PriorityRule> daScores = nullptr);
+
+// daScoreFile -> ScoreTablePriority, prints why and returns nullptr if the
+// file can't be read or has a malformed line
+std::shared_ptr<const PriorityRule> loadDAScores(const std::string& path);
+
+// display name used in console output, e.g. "da" -> "DA"
+std::string schedulerLabel(const std::string& name);
+
+#endif // SCHEDULER_FACTORY_H
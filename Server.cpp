@@ -29,9 +29,9 @@ void Server::clearAssignments() {
     usedCapacity_ = 0;
 }
 
-void Server::removeFinishedJobs(int currentTime, Simulation *sim) {
-    std::vector<Job*> stillRunning;
-    stillRunning.reserve(assignedJobs_.size());
+int Server::removeFinishedJobs(int currentTime, Simulation *sim, std::vector<Job*>* finished) {
+    // compact in place, no scratch vector per tick
+    std::size_t keep = 0;
 
     int freed = 0;
 
@@ -43,14 +43,16 @@ void Server::removeFinishedJobs(int currentTime, Simulation *sim) {
             if (elapsed >= job->duration()) {
                 job->markFinished(currentTime);
                 if (sim) sim->logJobFinish(job, currentTime);
+                if (finished) finished->push_back(job);
                 freed += job->trueDemand(); 
                 continue; 
             }
         }
 
-        stillRunning.push_back(job);
+        assignedJobs_[keep++] = job;
     }
 
-    assignedJobs_.swap(stillRunning);
+    assignedJobs_.resize(keep);
     usedCapacity_ -= freed;
+    return freed;
 }
@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <cstddef> // std::size_t
+#include <memory_resource>
 
 class Job; 
 
@@ -12,10 +13,13 @@ class Server {
 public:
     Server() = default;
 
-    Server(int id, int capacity)
+    // mr: where assignedJobs_ lives, pass the seed's Arena for arena-built servers
+    Server(int id, int capacity,
+           std::pmr::memory_resource* mr = std::pmr::get_default_resource())
         : id_(id),
           capacity_(capacity),
-          usedCapacity_(0) {}
+          usedCapacity_(0),
+          assignedJobs_(mr) {}
 
     int id() const { return id_; }
 
@@ -23,7 +27,12 @@ public:
     int usedCapacity() const { return usedCapacity_; }
     int freeCapacity() const { return capacity_ - usedCapacity_; }
 
-    const std::vector<Job*>& assignedJobs() const { return assignedJobs_; }
+    // place in the topology, 0/0 when servers are not grouped (see TopologyIndex)
+    int rack() const { return rack_; }
+    int pod() const { return pod_; }
+    void setLocation(int rack, int pod) { rack_ = rack; pod_ = pod; }
+
+    const std::pmr::vector<Job*>& assignedJobs() const { return assignedJobs_; }
 
     // try accept a job（基于 reported demand）
     bool canAccept(const Job* job) const;
@@ -37,16 +46,20 @@ public:
     // remove temporary matches
     void clearAssignments();
 
-    // remove finished jobs
-    void removeFinishedJobs(int currentTime, Simulation *sim);
+    // remove finished jobs, returns the freed capacity; finished jobs are
+    // appended to 'finished' when given
+    int removeFinishedJobs(int currentTime, Simulation *sim,
+                           std::vector<Job*>* finished = nullptr);
 
 private:
     int id_ = -1;
 
     int capacity_ = 0;
     int usedCapacity_ = 0;
+    int rack_ = 0;
+    int pod_  = 0;
 
-    std::vector<Job*> assignedJobs_;
+    std::pmr::vector<Job*> assignedJobs_;
 };
 
 #endif // SERVER_H
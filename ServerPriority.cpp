@@ -0,0 +1,74 @@
+#include "ServerPriority.h"
+#include "Job.h"
+#include "Server.h"
+
+#include <fstream>
+#include <sstream>
+
+long long DemandPriority::score(const Server&, const Job& job) const {
+    return -static_cast<long long>(job.reportedDemand());
+}
+
+long long ArrivalPriority::score(const Server&, const Job& job) const {
+    return -static_cast<long long>(job.arrivalTime());
+}
+
+long long ScoreTablePriority::key(int serverId, int jobId) {
+    return (static_cast<long long>(serverId) << 32) ^ static_cast<unsigned int>(jobId);
+}
+
+void ScoreTablePriority::set(int serverId, int jobId, long long score) {
+    table_[key(serverId, jobId)] = score;
+}
+
+long long ScoreTablePriority::score(const Server& server, const Job& job) const {
+    auto it = table_.find(key(server.id(), job.id()));
+    return it == table_.end() ? missing_ : it->second;
+}
+
+void PreferenceScorePriority::addJob(const std::vector<long long>& scores) {
+    scores_.insert(scores_.end(), scores.begin(), scores.end());
+    offset_.push_back(scores_.size());
+}
+
+long long PreferenceScorePriority::score(const Server& server, const Job& job) const {
+    const int* prefs = job.preferences();
+    for (int k = 0; k < job.numPreferences(); ++k) {
+        if (prefs[k] == server.id()) return scoreAt(server, job, k);
+    }
+    return 0;
+}
+
+long long PreferenceScorePriority::scoreAt(const Server&, const Job& job, int k) const {
+    return scores_[offset_[job.id()] + k];
+}
+
+bool ScoreTablePriority::loadCSV(const std::string& path, std::string* error) {
+    std::ifstream fin(path);
+    if (!fin) {
+        if (error) *error = "can't read '" + path + "'";
+        return false;
+    }
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(fin, line)) {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.find_first_not_of(" \t") == std::string::npos || line[0] == '#') continue;
+        for (char& c : line) {
+            if (c == ',') c = ' ';
+        }
+        std::istringstream ss(line);
+        int sid, jid;
+        long long sc;
+        if (!(ss >> sid >> jid >> sc) || !(ss >> std::ws).eof() || sid < 0 || jid < 0) {
+            if (error) {
+                *error = path + ":" + std::to_string(lineNo) + ": expected serverId,jobId,score";
+            }
+            return false;
+        }
+        set(sid, jid, sc);
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef SERVER_PRIORITY_H
+#define SERVER_PRIORITY_H
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+class Job;
+class Server;
+
+// PriorityRule：how a server ranks the jobs proposing to it (DAScheduler)
+// - score(): higher = preferred, ties go to the lower job id
+// - only evaluated while DA compiles its per-batch rank tables, so it may be
+//   as slow as a hash lookup; the rounds themselves compare integer ranks
+class PriorityRule {
+public:
+    virtual ~PriorityRule() = default;
+
+    virtual long long score(const Server& server, const Job& job) const = 0;
+
+    // score for the job's k-th listed server (== server); rules stored per
+    // preference slot override it to skip the lookup
+    virtual long long scoreAt(const Server& server, const Job& job, int k) const {
+        (void)k;
+        return score(server, job);
+    }
+
+    // true if every server ranks by ascending reportedDemand (then DA can
+    // skip the rank tables and use the serial pass)
+    virtual bool demandOrdered() const { return false; }
+};
+
+// default: smaller reported demand first
+class DemandPriority : public PriorityRule {
+public:
+    long long score(const Server& server, const Job& job) const override;
+    bool demandOrdered() const override { return true; }
+};
+
+// first come first served: earlier arrival first
+class ArrivalPriority : public PriorityRule {
+public:
+    long long score(const Server& server, const Job& job) const override;
+};
+
+// per-(server, job) scores from a trace, e.g. a legacy instance;
+// pairs not in the table get missingScore
+class ScoreTablePriority : public PriorityRule {
+public:
+    explicit ScoreTablePriority(long long missingScore = 0) : missing_(missingScore) {}
+
+    void set(int serverId, int jobId, long long score);
+    long long score(const Server& server, const Job& job) const override;
+
+    // "serverId,jobId,score" lines, '#' comments and blank lines skipped;
+    // false (and why in *error) if the file can't be read or a line is malformed
+    bool loadCSV(const std::string& path, std::string* error = nullptr);
+
+private:
+    std::unordered_map<long long, long long> table_;
+    long long missing_;
+
+    static long long key(int serverId, int jobId);
+};
+
+// per-job scores in preference-list order, e.g. a legacy instance
+// (scores[jobId][k] = score at the job's k-th server); jobs must keep the
+// list they were added with, and slots naming the same server need the same
+// score (see instancePriority)
+class PreferenceScorePriority : public PriorityRule {
+public:
+    void addJob(const std::vector<long long>& scores);
+
+    long long score(const Server& server, const Job& job) const override;
+    long long scoreAt(const Server& server, const Job& job, int k) const override;
+
+private:
+    std::vector<std::size_t> offset_ = {0}; // job id -> first slot
+    std::vector<long long> scores_;
+};
+
+#endif // SERVER_PRIORITY_H
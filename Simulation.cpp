@@ -3,19 +3,61 @@
 #include "Server.h"
 #include "Scheduler.h"
 #include "Metrics.h"
+#include "Trace.h"
 
 #include <vector>
 #include <string>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
 
 // check each job if they are finished
-void Simulation::updateFinishedJobs(std::vector<Server*>& servers, 
-                                    int currentTime,
-                                    Simulation *sim)
+int Simulation::updateFinishedJobs(std::vector<Server*>& servers, 
+                                   int currentTime,
+                                   Simulation *sim,
+                                   std::vector<Job*>* finished)
 {
+    TRACE_SCOPE("updateFinishedJobs", currentTime);
+    int freed = 0;
     for (Server* s : servers) {
         if (!s) continue;
-        s->removeFinishedJobs(currentTime, sim);
+        freed += s->removeFinishedJobs(currentTime, sim, finished);
+    }
+    return freed;
+}
+
+// a finished job counts down its children, a child whose last parent just
+// finished (and that was already submitted) becomes ready; O(children)
+int Simulation::releaseChildren(const std::vector<Job*>& finished, int currentTime,
+                                std::vector<Job*>& waiting) {
+    int released = 0;
+    for (Job* job : finished) {
+        for (int c = 0; c < job->numChildren(); ++c) {
+            Job* child = jobById_[job->children()[c]];
+            child->parentFinished();
+            if (child->pendingParents() == 0 && child->isWaiting() &&
+                child->arrivalTime() <= currentTime) {
+                waiting.push_back(child);
+                ++released;
+            }
+        }
+    }
+    return released;
+}
+
+// a failed job's descendants can never run, they fail with it
+void Simulation::failDescendants(Job* job, int currentTime) {
+    std::vector<Job*>& stack = dagStack_;
+    stack.assign(1, job);
+    while (!stack.empty()) {
+        Job* j = stack.back();
+        stack.pop_back();
+        for (int c = 0; c < j->numChildren(); ++c) {
+            Job* child = jobById_[j->children()[c]];
+            if (!child->isWaiting()) continue;
+            child->markFailed(currentTime);
+            stack.push_back(child);
+        }
     }
 }
 
@@ -41,18 +83,83 @@ Metrics Simulation::run(Scheduler& scheduler,
     double utilizationSum = 0.0;
     int   timeSteps       = 0;
     std::vector<Job*> waiting;
+    BatchController batcher(batchPolicy_, batchSize);
+    bool timeBatches = batchPolicy_.adaptive && batchPolicy_.costTargetUs > 0.0;
+
+    // workflow DAGs: jobs enter the waiting list only once all parents finished,
+    // schedulers only ever see ready jobs
+    bool dag = false;
+    int maxJobId = 0;
+    for (Job* j : jobs) {
+        if (!j) continue;
+        dag = dag || j->numChildren() > 0;
+        maxJobId = std::max(maxJobId, j->id());
+    }
+    std::vector<Job*> finishedNow;
+    if (dag) {
+        jobById_.assign(maxJobId + 1, nullptr);
+        for (Job* j : jobs) {
+            if (j && j->id() >= 0) jobById_[j->id()] = j;
+        }
+    }
 
     for (currentTime = 0; currentTime <= timeLimit_; ++currentTime) {
+        int arrived = 0;
         for (Job* j : jobs) {
             if (j && j->arrivalTime() == currentTime) {
+                if (j->pendingParents() > 0) continue; // released by its last parent
                 waiting.push_back(j);
+                ++arrived;
             }
         }
 
-        updateFinishedJobs(servers, currentTime, sim);
+        finishedNow.clear();
+        int freed = updateFinishedJobs(servers, currentTime, sim, dag ? &finishedNow : nullptr);
+        if (dag) arrived += releaseChildren(finishedNow, currentTime, waiting);
+        batcher.onArrivals(arrived, currentTime);
+        batcher.onCapacityFreed(freed);
+
+        if (batcher.due(currentTime)) {
+            if (batcher.dirty()) {
+                if (traceReplay_) {
+                    replayTrace_.batchTimes.push_back(currentTime);
+                    replayTrace_.batchers.push_back(batcher);
+                }
 
-        if (currentTime % batchSize == 0) {
-            scheduler.runBatch(waiting, servers, currentTime, this);
+                int queueIn = static_cast<int>(waiting.size());
+
+                auto t0 = std::chrono::steady_clock::now();
+                {
+                    TRACE_SCOPE("runBatch", queueIn);
+                    scheduler.runBatch(waiting, servers, currentTime, this);
+                }
+                double costUs = 0.0;
+                if (timeBatches) {
+                    costUs = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - t0).count();
+                }
+
+                if (dag) {
+                    for (Job* j : waiting) {
+                        if (j && j->isFailed() && j->numChildren() > 0) failDescendants(j, currentTime);
+                    }
+                }
+
+                // drop placed/failed jobs, order of the rest is kept
+                waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+                                             [](Job* j) { return !j || !j->isWaiting(); }),
+                              waiting.end());
+
+                batcher.onBatch(currentTime, queueIn,
+                                static_cast<int>(waiting.size()), costUs);
+                if (scheduler.hasCarriedWork()) batcher.onCarry();
+            } else {
+                batcher.onSkip();
+            }
+        }
+
+        if (trackOccupancy_) {
+            recordOccupancy(servers, currentTime);
         }
 
         // record capacity used
@@ -68,6 +175,23 @@ Metrics Simulation::run(Scheduler& scheduler,
     }
 
     // stat metrics
+    TRACE_SCOPE("metrics");
+    collectMetrics(jobs, metrics);
+    if (timeSteps > 0) {
+        metrics.avgUtilization = utilizationSum / timeSteps;
+    }
+
+    if (dag) workflowMetrics(jobs, metrics);
+
+    metrics.numBatches     = batcher.batches();
+    metrics.skippedBatches = batcher.skipped();
+    metrics.maxBatchDelay  = batcher.maxObservedDelay();
+
+    return metrics;
+}
+
+// everything but utilization and batch counts, from the jobs' final state
+void Simulation::collectMetrics(const std::vector<Job*>& jobs, Metrics& metrics) const {
     int finished = 0;
     double sumCompletion = 0.0;
     double sumWaiting = 0.0;
@@ -89,15 +213,162 @@ Metrics Simulation::run(Scheduler& scheduler,
         metrics.avgWaitingTime    = sumWaiting    / finished;
     }
 
-    if (timeSteps > 0) {
-        metrics.avgUtilization = utilizationSum / timeSteps;
+    // waiting tail, jobs that never started are censored at timeLimit+1
+    std::vector<int> waits;
+    waits.reserve(jobs.size());
+    for (Job* job : jobs) {
+        if (!job) continue;
+        int start = (job->startTime() >= 0) ? job->startTime() : timeLimit_ + 1;
+        waits.push_back(start - job->arrivalTime());
+    }
+    if (!waits.empty()) {
+        std::sort(waits.begin(), waits.end());
+        metrics.waitingP95     = waits[static_cast<std::size_t>(0.95 * (waits.size() - 1))];
+        metrics.maxWaitingTime = waits.back();
     }
 
-    return metrics;
+    // per-tenant usage + Jain's index, only with more than one tenant
+    int maxTenant = 0;
+    for (Job* job : jobs) {
+        if (job) maxTenant = std::max(maxTenant, job->tenant());
+    }
+    if (maxTenant > 0) {
+        metrics.tenants.assign(maxTenant + 1, TenantMetrics());
+        double totalUsage = 0.0;
+        for (Job* job : jobs) {
+            if (!job || job->tenant() < 0) continue;
+            TenantMetrics& t = metrics.tenants[job->tenant()];
+            ++t.jobs;
+            if (job->isFinished()) ++t.finished;
+            t.requested += static_cast<double>(job->trueDemand()) * std::max(job->duration(), 1);
+            if (job->startTime() >= 0 && !job->isFailed()) {
+                int end = job->isFinished() ? job->finishTime() : timeLimit_ + 1;
+                double used = static_cast<double>(job->trueDemand()) * (end - job->startTime());
+                t.usage += used;
+                totalUsage += used;
+            }
+        }
+        double sum = 0.0, sumSq = 0.0;
+        int n = 0;
+        for (TenantMetrics& t : metrics.tenants) {
+            if (totalUsage > 0.0) t.share = t.usage / totalUsage;
+            if (t.requested <= 0.0) continue; // no jobs, not part of the index
+            t.served = t.usage / t.requested;
+            sum   += t.served;
+            sumSq += t.served * t.served;
+            ++n;
+        }
+        metrics.jainIndex = (sumSq > 0.0) ? (sum * sum) / (n * sumSq) : 1.0;
+    }
+
+    // deadline metrics, over jobs that carry one
+    std::vector<int> lateness;
+    for (Job* job : jobs) {
+        if (!job || !job->hasDeadline()) continue;
+        int finish = job->isFinished() ? job->finishTime() : timeLimit_ + 1;
+        lateness.push_back(finish - job->deadline());
+        if (finish > job->deadline()) ++metrics.deadlineMisses;
+    }
+    metrics.deadlineJobs = static_cast<int>(lateness.size());
+    if (!lateness.empty()) {
+        std::sort(lateness.begin(), lateness.end());
+        auto pct = [&lateness](double q) -> double {
+            return lateness[static_cast<std::size_t>(q * (lateness.size() - 1))];
+        };
+        metrics.missRate    = static_cast<double>(metrics.deadlineMisses) / metrics.deadlineJobs;
+        metrics.latenessP50 = pct(0.50);
+        metrics.latenessP95 = pct(0.95);
+        metrics.latenessP99 = pct(0.99);
+    }
+}
+
+// critical path by a forward pass in topological order (Kahn), then per
+// workflow: submission, last finish, longest chain
+void Simulation::workflowMetrics(const std::vector<Job*>& jobs, Metrics& metrics) const {
+    std::vector<int> indeg(jobById_.size(), 0);
+    std::vector<long long> chain(jobById_.size(), 0); // longest chain ending here
+    std::vector<Job*> queue;
+    int maxWorkflow = -1;
+    for (Job* j : jobs) {
+        if (!j || j->id() < 0) continue;
+        indeg[j->id()] = j->numParents();
+        if (j->numParents() == 0) queue.push_back(j);
+        maxWorkflow = std::max(maxWorkflow, j->workflow());
+    }
+    for (std::size_t q = 0; q < queue.size(); ++q) {
+        Job* j = queue[q];
+        chain[j->id()] += j->duration();
+        for (int c = 0; c < j->numChildren(); ++c) {
+            int cid = j->children()[c];
+            chain[cid] = std::max(chain[cid], chain[j->id()]);
+            if (--indeg[cid] == 0) queue.push_back(jobById_[cid]);
+        }
+    }
+
+    struct Flow { int submit = -1; int finish = -1; long long critical = 0; bool done = true; };
+    std::vector<Flow> flows(maxWorkflow + 1);
+    for (Job* j : jobs) {
+        if (!j || j->workflow() < 0) continue;
+        Flow& f = flows[j->workflow()];
+        f.submit = (f.submit < 0) ? j->arrivalTime() : std::min(f.submit, j->arrivalTime());
+        f.critical = std::max(f.critical, chain[j->id()]);
+        if (j->isFinished()) f.finish = std::max(f.finish, j->finishTime());
+        else f.done = false;
+    }
+
+    std::vector<double> stretch;
+    double makespanSum = 0.0;
+    for (const Flow& f : flows) {
+        if (f.submit < 0) continue;
+        ++metrics.workflows;
+        if (!f.done) continue;
+        ++metrics.workflowsDone;
+        makespanSum += f.finish - f.submit;
+        stretch.push_back(static_cast<double>(f.finish - f.submit) / std::max(f.critical, 1LL));
+    }
+    if (!stretch.empty()) {
+        double sum = 0.0;
+        for (double s : stretch) sum += s;
+        std::sort(stretch.begin(), stretch.end());
+        metrics.makespanAvg = makespanSum / stretch.size();
+        metrics.stretchMean = sum / stretch.size();
+        metrics.stretchP95  = stretch[static_cast<std::size_t>(0.95 * (stretch.size() - 1))];
+    }
+}
+
+void Simulation::recordOccupancy(std::vector<Server*>& servers, int currentTime) {
+    if (occupancy_.size() < servers.size()) {
+        occupancy_.resize(servers.size());
+    }
+    for (std::size_t si = 0; si < servers.size(); ++si) {
+        if (!servers[si]) continue;
+        int used = servers[si]->usedCapacity();
+        auto& runs = occupancy_[si];
+        // extend the current run while the level stays the same
+        if (!runs.empty() && runs.back().used == used && runs.back().endTime == currentTime) {
+            runs.back().endTime = currentTime + 1;
+        } else {
+            runs.push_back({currentTime, currentTime + 1, used});
+        }
+    }
 }
 
 void Simulation::logJobStart(Job* job, Server* server, int currentTime) {
     if (!job || !server) return;
+    if (traceReplay_ && job->id() >= 0) {
+        auto& byJob = replayTrace_.serverIdByJob;
+        if (static_cast<int>(byJob.size()) <= job->id()) byJob.resize(job->id() + 1, -1);
+        byJob[job->id()] = server->id();
+    }
+    if (recordSampleEvery_ <= 0) return;
+    int jid = job->id();
+    if (jid < 0 || jid % recordSampleEvery_ != 0) return;
+
+    if (static_cast<int>(recordIndexByJob_.size()) <= jid) {
+        recordIndexByJob_.resize(jid + 1, -1);
+    }
+    recordIndexByJob_[jid] = static_cast<int>(runRecords_.size());
+
     JobRunRecord rec;
     rec.jobId    = job->id();          
     rec.serverId = server->id();
@@ -110,12 +381,12 @@ void Simulation::logJobStart(Job* job, Server* server, int currentTime) {
 void Simulation::logJobFinish(Job* job, int currentTime) {
     if (!job) return;
     int jid = job->id();
-    // find last record which hasn't record end time
-    for (int i = static_cast<int>(runRecords_.size()) - 1; i >= 0; --i) {
-        if (runRecords_[i].jobId == jid && runRecords_[i].endTime < 0) {
-            runRecords_[i].endTime = currentTime;
-            break;
-        }
+    // O(1) lookup of the open record, unsampled jobs have none
+    if (jid < 0 || jid >= static_cast<int>(recordIndexByJob_.size())) return;
+    int idx = recordIndexByJob_[jid];
+    if (idx < 0) return;
+    if (runRecords_[idx].endTime < 0) {
+        runRecords_[idx].endTime = currentTime;
     }
 }
 
@@ -135,6 +406,38 @@ void Simulation::dumpRunRecordsToCSV(const std::string& filename, std::vector<Se
     }
 }
 
+void Simulation::dumpOccupancyToCSV(const std::string& filename, std::vector<Server*>& servers) const {
+    std::ofstream out(filename);
+    if (!out) return;
+    out << "serverId,startTime,endTime,used,serverCap\n";
+    for (std::size_t si = 0; si < occupancy_.size() && si < servers.size(); ++si) {
+        if (!servers[si]) continue;
+        int sid = servers[si]->id();
+        int cap = servers[si]->capacity();
+        for (const auto& r : occupancy_[si]) {
+            out << sid         << ","
+                << r.startTime << ","
+                << r.endTime   << ","
+                << r.used      << ","
+                << cap         << "\n";
+        }
+    }
+}
+
 void Simulation::clearRunRecords() {
     runRecords_.clear();
-}
\ No newline at end of file
+    recordIndexByJob_.clear();
+    occupancy_.clear();
+    replayTrace_ = ReplayTrace();
+}
+
+MemUsage Simulation::traceUsage() const {
+    MemUsage u;
+    u.addVector(runRecords_);
+    u.addVector(recordIndexByJob_);
+    u.addVector(occupancy_);
+    u.addVector(replayTrace_.serverIdByJob);
+    u.addVector(replayTrace_.batchTimes);
+    u.addVector(replayTrace_.batchers);
+    return u;
+}
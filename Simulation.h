@@ -4,6 +4,9 @@
 #include <vector>
 #include <string>
 
+#include "BatchController.h"
+#include "MemStats.h"
+
 class Job;
 class Server;
 class Scheduler;
@@ -17,6 +20,21 @@ struct JobRunRecord {
     int demand;    
 };
 
+// One run of a server's occupancy step function：
+// usedCapacity == used for every t in [startTime, endTime)
+struct OccupancyRun {
+    int startTime;
+    int endTime;
+    int used;
+};
+
+// What a run leaves behind for counterfactual replay (see Counterfactual.h)
+struct ReplayTrace {
+    std::vector<int> serverIdByJob;        // job id -> server it was placed on, -1 = never
+    std::vector<int> batchTimes;           // ticks where runBatch was called
+    std::vector<BatchController> batchers; // controller state right before each of those batches
+};
+
 // Simulation：
 // - Apply scheduler.runBatch when t=0；
 // - From t=0 to timeLimit，jobs are finished and release capacity according to duration；
@@ -33,17 +51,62 @@ public:
                 Simulation *sim);
       
     void dumpRunRecordsToCSV(const std::string& filename, std::vector<Server*>& servers) const;
+    void dumpOccupancyToCSV(const std::string& filename, std::vector<Server*>& servers) const;
     void logJobStart(Job* job, Server* server, int currentTime);
     void logJobFinish(Job* job, int currentTime);
     void clearRunRecords(); 
 
+    // job records: keep 1 of every n jobs (by id), 0 turns recording off
+    void setRecordSampling(int every) { recordSampleEvery_ = every; }
+    // per-server run-length encoded occupancy, recorded once per tick
+    void setOccupancyTracking(bool on) { trackOccupancy_ = on; }
+
+    // when runBatch is called, see BatchController
+    void setBatchPolicy(const BatchPolicy& policy) { batchPolicy_ = policy; }
+    const BatchPolicy& batchPolicy() const { return batchPolicy_; }
+
+    // record a ReplayTrace during run(), cleared by clearRunRecords()
+    void setReplayTracing(bool on) { traceReplay_ = on; }
+    const ReplayTrace& replayTrace() const { return replayTrace_; }
+
+    int timeLimit() const { return timeLimit_; }
+
+    // records + timelines + replay trace held right now, for memStats=1
+    MemUsage traceUsage() const;
+
+    // completion / waiting / tail / tenant / deadline metrics of finished jobs,
+    // jobs that never started count up to timeLimit+1 (also ReplicatedSimulation)
+    void collectMetrics(const std::vector<Job*>& jobs, Metrics& metrics) const;
+
 private:
     int timeLimit_;
     std::vector<JobRunRecord> runRecords_;
+    std::vector<int> recordIndexByJob_; // job id -> index in runRecords_, -1 = none
+
+    int  recordSampleEvery_ = 1;
+    bool trackOccupancy_    = false;
+    std::vector<std::vector<OccupancyRun>> occupancy_; // indexed like servers
+
+    BatchPolicy batchPolicy_;
+
+    bool traceReplay_ = false;
+    ReplayTrace replayTrace_;
+
+    void recordOccupancy(std::vector<Server*>& servers, int currentTime);
+
+    // returns the total freed capacity, finished jobs go to 'finished' if given
+    int updateFinishedJobs(std::vector<Server*>& servers,
+                           int currentTime,
+                           Simulation *sim,
+                           std::vector<Job*>* finished = nullptr);
 
-    void updateFinishedJobs(std::vector<Server*>& servers,
-                            int currentTime,
-                            Simulation *sim);
+    // workflow DAGs, see Job::children()
+    std::vector<Job*> jobById_;
+    std::vector<Job*> dagStack_;
+    int releaseChildren(const std::vector<Job*>& finished, int currentTime,
+                        std::vector<Job*>& waiting);
+    void failDescendants(Job* job, int currentTime);
+    void workflowMetrics(const std::vector<Job*>& jobs, Metrics& metrics) const;
 };
 
 #endif // SIMULATION_H
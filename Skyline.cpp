@@ -0,0 +1,71 @@
+#include "Skyline.h"
+
+#include <algorithm>
+#include <climits>
+
+void Skyline::build(int now, int freeNow, std::vector<std::pair<int, int>>& releases) {
+    steps_.clear();
+    std::sort(releases.begin(), releases.end());
+    int level = freeNow;
+    steps_.emplace(now, level);
+    for (const auto& r : releases) {
+        level += r.second;
+        steps_[std::max(r.first, now)] = level; // same tick: the last one holds the sum
+    }
+}
+
+std::map<int, int>::const_iterator Skyline::stepAt(int t) const {
+    auto it = steps_.upper_bound(t);
+    return (it == steps_.begin()) ? it : std::prev(it);
+}
+
+std::map<int, int>::iterator Skyline::split(int t) {
+    auto it = steps_.lower_bound(t);
+    if (it != steps_.end() && it->first == t) return it;
+    int level = std::prev(it)->second;
+    return steps_.emplace_hint(it, t, level);
+}
+
+void Skyline::reserve(int start, int end, int amount) {
+    if (steps_.empty() || start >= end) return;
+    start = std::max(start, steps_.begin()->first);
+    auto last = split(end);
+    for (auto it = split(start); it != last; ++it) it->second -= amount;
+}
+
+int Skyline::freeAt(int t) const {
+    if (steps_.empty()) return 0;
+    return stepAt(t)->second;
+}
+
+int Skyline::minFree(int start, int end) const {
+    if (steps_.empty()) return 0;
+    int best = INT_MAX;
+    for (auto it = stepAt(start); it != steps_.end() && it->first < end; ++it) {
+        best = std::min(best, it->second);
+    }
+    return best;
+}
+
+int Skyline::earliestFit(int from, int length, int amount) const {
+    if (steps_.empty()) return -1;
+    from = std::max(from, steps_.begin()->first);
+    length = std::max(length, 1);
+
+    // t = candidate start; scan the steps overlapping [t, t + length)
+    int t = from;
+    auto it = stepAt(t);
+    while (it != steps_.end()) {
+        if (it->second < amount) {
+            // too full here, the next candidate is the next breakpoint
+            ++it;
+            if (it == steps_.end()) return -1; // the final level never fits
+            t = it->first;
+            continue;
+        }
+        auto next = std::next(it);
+        if (next == steps_.end() || next->first >= t + length) return t;
+        it = next;
+    }
+    return -1;
+}
@@ -0,0 +1,38 @@
+#ifndef SKYLINE_H
+#define SKYLINE_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+// Skyline：free capacity of one server as a step function of future time
+// - steps_[t] = free capacity from tick t until the next breakpoint, the
+//   last step lasts forever
+// - reserve / minFree / earliestFit cost O(log b + k) for b breakpoints and
+//   k breakpoints inside the queried window
+class Skyline {
+public:
+    // free = freeNow from 'now' on, plus each (tick, amount) release
+    // (a running job giving its capacity back) from that tick on
+    void build(int now, int freeNow, std::vector<std::pair<int, int>>& releases);
+
+    // take 'amount' over [start, end)
+    void reserve(int start, int end, int amount);
+
+    int freeAt(int t) const;
+    int minFree(int start, int end) const; // over [start, end)
+
+    // earliest t >= from with minFree(t, t + length) >= amount, -1 if never
+    int earliestFit(int from, int length, int amount) const;
+
+    std::size_t breakpoints() const { return steps_.size(); }
+
+private:
+    std::map<int, int> steps_;
+
+    // make t a breakpoint (t >= first breakpoint), returns it
+    std::map<int, int>::iterator split(int t);
+    std::map<int, int>::const_iterator stepAt(int t) const;
+};
+
+#endif // SKYLINE_H
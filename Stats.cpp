@@ -0,0 +1,154 @@
+#include "Stats.h"
+
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+void RunningStat::kahanAdd(double x) {
+    double y = x - comp_;
+    double t = sum_ + y;
+    comp_ = (t - sum_) - y;
+    sum_ = t;
+}
+
+void RunningStat::add(double x) {
+    ++n_;
+    double delta = x - mean_;
+    mean_ += delta / n_;
+    m2_ += delta * (x - mean_);
+    kahanAdd(x);
+}
+
+void RunningStat::merge(const RunningStat& other) {
+    if (other.n_ == 0) return;
+    if (n_ == 0) {
+        *this = other;
+        return;
+    }
+    long long n = n_ + other.n_;
+    double delta = other.mean_ - mean_;
+    m2_ += other.m2_ + delta * delta * (static_cast<double>(n_) * other.n_ / n);
+    mean_ += delta * other.n_ / n;
+    n_ = n;
+    kahanAdd(other.sum_);
+    kahanAdd(-other.comp_);
+}
+
+double RunningStat::stddev() const {
+    return std::sqrt(variance());
+}
+
+double RunningStat::ciHalfWidth() const {
+    if (n_ < 2) return 0.0;
+    return tCritical95(n_ - 1) * stddev() / std::sqrt(static_cast<double>(n_));
+}
+
+double tCritical95(long long df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+         2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+         2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df <= 0) return 0.0;
+    if (df <= 30) return table[df - 1];
+    // Cornish-Fisher expansion around the normal quantile
+    const double z = 1.959964;
+    double d = static_cast<double>(df);
+    return z + (z * z * z + z) / (4.0 * d)
+             + (5.0 * std::pow(z, 5) + 16.0 * z * z * z + 3.0 * z) / (96.0 * d * d);
+}
+
+SeedAggregator::Row& SeedAggregator::row(const std::string& type) {
+    for (Row& r : rows_) {
+        if (r.type == type) return r;
+    }
+    rows_.push_back(Row());
+    rows_.back().type = type;
+    return rows_.back();
+}
+
+void SeedAggregator::add(const std::string& type, const Metrics& m) {
+    Row& r = row(type);
+    r.finishedJobs.add(m.finishedJobs);
+    r.avgCompletionTime.add(m.avgCompletionTime);
+    r.avgWaitingTime.add(m.avgWaitingTime);
+    r.avgUtilization.add(m.avgUtilization);
+}
+
+void SeedAggregator::addPaired(const std::string& typeA, const Metrics& a,
+                               const std::string& typeB, const Metrics& b) {
+    Row& r = row(typeA + "-" + typeB);
+    r.finishedJobs.add(static_cast<double>(a.finishedJobs) - b.finishedJobs);
+    r.avgCompletionTime.add(a.avgCompletionTime - b.avgCompletionTime);
+    r.avgWaitingTime.add(a.avgWaitingTime - b.avgWaitingTime);
+    r.avgUtilization.add(a.avgUtilization - b.avgUtilization);
+}
+
+void SeedAggregator::merge(const SeedAggregator& other) {
+    for (const Row& o : other.rows_) {
+        Row& r = row(o.type);
+        r.finishedJobs.merge(o.finishedJobs);
+        r.avgCompletionTime.merge(o.avgCompletionTime);
+        r.avgWaitingTime.merge(o.avgWaitingTime);
+        r.avgUtilization.merge(o.avgUtilization);
+    }
+}
+
+const RunningStat* SeedAggregator::metric(const Row& r, const std::string& name) {
+    if (name == "finishedJobs")  return &r.finishedJobs;
+    if (name == "avgCompletion") return &r.avgCompletionTime;
+    if (name == "avgWaiting")    return &r.avgWaitingTime;
+    if (name == "util")          return &r.avgUtilization;
+    return nullptr;
+}
+
+bool SeedAggregator::converged(const std::vector<std::string>& specs,
+                               double absTarget, double relTarget, long long minCount) const {
+    auto narrow = [&](const RunningStat& s) {
+        if (s.count() < minCount || s.count() < 2) return false;
+        double hw = s.ciHalfWidth();
+        if (absTarget > 0.0 && hw <= absTarget) return true;
+        if (relTarget > 0.0 && hw <= relTarget * std::fabs(s.mean())) return true;
+        return false;
+    };
+
+    bool any = false;
+    for (const std::string& spec : specs) {
+        std::size_t colon = spec.find(':');
+        std::string type = (colon == std::string::npos) ? "" : spec.substr(0, colon);
+        std::string name = (colon == std::string::npos) ? spec : spec.substr(colon + 1);
+        for (const Row& r : rows_) {
+            if (!type.empty() && r.type != type) continue;
+            const RunningStat* s = metric(r, name);
+            if (!s) continue;
+            if (!narrow(*s)) return false;
+            any = true;
+        }
+    }
+    return any;
+}
+
+void SeedAggregator::print() const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(std::cout);
+    std::cout << std::fixed << std::setprecision(4);
+
+    auto cell = [](const RunningStat& s) {
+        std::cout << "  " << std::setw(11) << s.mean() << " +- " << std::setw(9) << s.ciHalfWidth();
+    };
+
+    std::cout << std::left << std::setw(24) << "type" << std::right
+              << "  " << std::setw(24) << "finishedJobs"
+              << "  " << std::setw(24) << "avgCompletion"
+              << "  " << std::setw(24) << "avgWaiting"
+              << "  " << std::setw(24) << "util" << "\n";
+    for (const Row& r : rows_) {
+        std::cout << std::left << std::setw(24) << r.type << std::right;
+        cell(r.finishedJobs);
+        cell(r.avgCompletionTime);
+        cell(r.avgWaitingTime);
+        cell(r.avgUtilization);
+        std::cout << "\n";
+    }
+    std::cout.copyfmt(oldState);
+}
@@ -0,0 +1,75 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <string>
+#include <vector>
+
+#include "Metrics.h"
+
+// RunningStat：one metric over many seeds, O(1) memory
+// - Welford update for mean / variance, Kahan-compensated total
+// - merge() combines partial results (e.g. one per worker thread)
+//   with the pairwise formula, same answer as adding all values to one
+class RunningStat {
+public:
+    void add(double x);
+    void merge(const RunningStat& other);
+
+    long long count() const { return n_; }
+    double sum() const { return sum_ - comp_; }
+    double mean() const { return n_ > 0 ? sum() / n_ : 0.0; }
+    double variance() const { return n_ > 1 ? m2_ / (n_ - 1) : 0.0; } // sample variance
+    double stddev() const;
+    double ciHalfWidth() const; // 95% Student-t interval of the mean
+
+private:
+    long long n_ = 0;
+    double mean_ = 0.0; // Welford running mean, only used for m2_
+    double m2_   = 0.0;
+    double sum_  = 0.0;
+    double comp_ = 0.0; // Kahan compensation
+
+    void kahanAdd(double x);
+};
+
+// two-sided 95% critical value of Student's t
+double tCritical95(long long df);
+
+// SeedAggregator：cross-seed summary of every scenario
+// - add() once per (seed, scenario), addPaired() for per-seed differences
+//   of two scenarios on the same workload (e.g. da_strat - base_strat)
+// - rows keep the order they were first added in
+class SeedAggregator {
+public:
+    struct Row {
+        std::string type; // scenario type, or "a-b" for a paired difference
+        RunningStat finishedJobs;
+        RunningStat avgCompletionTime;
+        RunningStat avgWaitingTime;
+        RunningStat avgUtilization;
+    };
+
+    void add(const std::string& type, const Metrics& m);
+    void addPaired(const std::string& typeA, const Metrics& a,
+                   const std::string& typeB, const Metrics& b);
+    void merge(const SeedAggregator& other);
+
+    const std::vector<Row>& rows() const { return rows_; }
+    void print() const;
+
+    // "finishedJobs" / "avgCompletion" / "avgWaiting" / "util", nullptr if unknown
+    static const RunningStat* metric(const Row& r, const std::string& name);
+
+    // sequential stopping rule: every selected stat has >= minCount values and a
+    // CI half-width <= absTarget or <= relTarget * |mean| (targets <= 0 unused).
+    // spec is "metric" (all rows) or "type:metric"
+    bool converged(const std::vector<std::string>& specs,
+                   double absTarget, double relTarget, long long minCount) const;
+
+private:
+    std::vector<Row> rows_;
+
+    Row& row(const std::string& type);
+};
+
+#endif // STATS_H
@@ -0,0 +1,166 @@
+#include "Topology.h"
+#include "Server.h"
+
+#include <algorithm>
+
+void TopologyIndex::build(const std::vector<Server*>& servers) {
+    int n = static_cast<int>(servers.size());
+
+    // same servers in the same places as last time: only refresh capacities
+    std::vector<std::pair<int, int>>& loc = scratchLoc_;
+    loc.assign(n, {-1, -1});
+    for (int si = 0; si < n; ++si) {
+        if (servers[si]) loc[si] = {servers[si]->pod(), servers[si]->rack()};
+    }
+    if (loc == builtLoc_ && servers == built_) {
+        for (int si = 0; si < n; ++si) {
+            if (servers[si]) free_[si] = servers[si]->freeCapacity();
+        }
+        for (int r = 0; r < numRacks(); ++r) aggregateRack(r);
+        for (int p = 0; p < numPods(); ++p) aggregatePod(p);
+        aggregateRoot();
+        return;
+    }
+    built_ = servers;
+    builtLoc_.swap(loc);
+
+    // S1. group server indices by (pod, rack)
+    std::vector<int> order;
+    order.reserve(n);
+    for (int si = 0; si < n; ++si) {
+        if (servers[si]) order.push_back(si);
+    }
+    std::sort(order.begin(), order.end(), [&servers](int a, int b) {
+        const Server* x = servers[a];
+        const Server* y = servers[b];
+        if (x->pod() != y->pod()) return x->pod() < y->pod();
+        if (x->rack() != y->rack()) return x->rack() < y->rack();
+        return a < b;
+    });
+
+    free_.assign(n, -1);
+    rackOf_.assign(n, -1);
+    rackFirst_.clear();
+    rackServers_.clear();
+    podOf_.clear();
+    podFirst_.clear();
+    podRacks_.clear();
+
+    // S2. runs of equal rack form rack nodes, runs of equal pod form pod nodes
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        int si = order[k];
+        const Server* s = servers[si];
+        bool newPod = (k == 0 || servers[order[k - 1]]->pod() != s->pod());
+        bool newRack = newPod || servers[order[k - 1]]->rack() != s->rack();
+        if (newPod) {
+            podFirst_.push_back(static_cast<int>(podRacks_.size()));
+        }
+        if (newRack) {
+            podRacks_.push_back(static_cast<int>(rackFirst_.size()));
+            podOf_.push_back(static_cast<int>(podFirst_.size()) - 1);
+            rackFirst_.push_back(static_cast<int>(rackServers_.size()));
+        }
+        rackServers_.push_back(si);
+        rackOf_[si] = static_cast<int>(rackFirst_.size()) - 1;
+        free_[si] = s->freeCapacity();
+    }
+    rackFirst_.push_back(static_cast<int>(rackServers_.size()));
+    podFirst_.push_back(static_cast<int>(podRacks_.size()));
+
+    // S3. aggregate bottom up
+    rackMax_.assign(rackFirst_.size() - 1, -1);
+    podMax_.assign(podFirst_.size() - 1, -1);
+    for (int r = 0; r < numRacks(); ++r) aggregateRack(r);
+    for (int p = 0; p < numPods(); ++p) aggregatePod(p);
+    aggregateRoot();
+}
+
+void TopologyIndex::aggregateRack(int r) {
+    int m = -1;
+    for (int k = rackFirst_[r]; k < rackFirst_[r + 1]; ++k) {
+        m = std::max(m, free_[rackServers_[k]]);
+    }
+    rackMax_[r] = m;
+}
+
+void TopologyIndex::aggregatePod(int p) {
+    int m = -1;
+    for (int k = podFirst_[p]; k < podFirst_[p + 1]; ++k) {
+        m = std::max(m, rackMax_[podRacks_[k]]);
+    }
+    podMax_[p] = m;
+}
+
+void TopologyIndex::aggregateRoot() {
+    rootMax_ = podMax_.empty() ? -1 : *std::max_element(podMax_.begin(), podMax_.end());
+}
+
+void TopologyIndex::update(int si, int freeCapacity) {
+    if (si < 0 || si >= static_cast<int>(free_.size()) || rackOf_[si] < 0) return;
+    free_[si] = freeCapacity;
+    int r = rackOf_[si];
+    aggregateRack(r);
+    aggregatePod(podOf_[r]);
+    aggregateRoot();
+}
+
+int TopologyIndex::place(int demand, int homeSi) {
+    if (rootMax_ < demand) return -1;
+
+    int homeRack = (homeSi >= 0 && homeSi < static_cast<int>(rackOf_.size())) ? rackOf_[homeSi] : -1;
+    int homePod = (homeRack >= 0) ? podOf_[homeRack] : -1;
+
+    // home child if it fits, else the child with the smallest max free that fits
+    auto pick = [this, demand](const std::vector<int>& children, int first, int last,
+                               const std::vector<int>& maxFree, int home) {
+        if (home >= 0 && maxFree[home] >= demand) {
+            ++visits_;
+            return home;
+        }
+        int best = -1;
+        for (int k = first; k < last; ++k) {
+            int c = children[k];
+            ++visits_;
+            if (maxFree[c] >= demand && (best < 0 || maxFree[c] < maxFree[best])) best = c;
+        }
+        return best;
+    };
+
+    // S1. pod, over all pods (the root's children)
+    int p;
+    if (homePod >= 0 && podMax_[homePod] >= demand) {
+        ++visits_;
+        p = homePod;
+    } else {
+        p = -1;
+        for (int q = 0; q < numPods(); ++q) {
+            ++visits_;
+            if (podMax_[q] >= demand && (p < 0 || podMax_[q] < podMax_[p])) p = q;
+        }
+    }
+
+    // S2. rack inside that pod
+    int r = pick(podRacks_, podFirst_[p], podFirst_[p + 1], rackMax_,
+                 (homePod == p) ? homeRack : -1);
+
+    // S3. best-fit server inside that rack
+    int si = pick(rackServers_, rackFirst_[r], rackFirst_[r + 1], free_, -1);
+    return si;
+}
+
+MemUsage TopologyIndex::scratchUsage() const {
+    MemUsage u;
+    u.addVector(free_);
+    u.addVector(rackOf_);
+    u.addVector(rackFirst_);
+    u.addVector(rackServers_);
+    u.addVector(rackMax_);
+    u.addVector(podOf_);
+    u.addVector(podFirst_);
+    u.addVector(podRacks_);
+    u.addVector(podMax_);
+    u.addVector(built_);
+    u.addVector(builtLoc_);
+    u.addVector(scratchLoc_);
+    return u;
+}
@@ -0,0 +1,62 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <vector>
+#include <utility>
+
+#include "MemStats.h"
+
+class Server;
+
+// TopologyIndex：cluster -> pods -> racks -> servers (Server::pod() / rack()),
+// every node keeps the largest free capacity below it
+// - place() descends only into children that still fit the demand, so it
+//   finds a server in O(depth x fanout) instead of O(servers); there is no
+//   backtracking, a child that fits always has a server that fits
+// - at each level the job's home pod / rack wins when it fits, otherwise the
+//   tightest-fitting child (smallest max free), best-fit among the rack's servers
+// - update() re-aggregates one server's ancestors, O(depth x fanout)
+class TopologyIndex {
+public:
+    // servers[si] keeps index si; rack / pod ids are grouped, they need not be
+    // dense. O(servers log servers) for a new server list, O(servers) to refresh
+    void build(const std::vector<Server*>& servers);
+
+    // server index for a job of this demand, -1 if none fits
+    // homeSi: server whose rack / pod the job prefers, -1 = none
+    int place(int demand, int homeSi);
+
+    void update(int si, int freeCapacity);
+
+    bool sameRack(int a, int b) const { return rackOf_[a] == rackOf_[b]; }
+    bool samePod(int a, int b) const { return podOf_[rackOf_[a]] == podOf_[rackOf_[b]]; }
+
+    int numRacks() const { return static_cast<int>(rackMax_.size()); }
+    int numPods() const { return static_cast<int>(podMax_.size()); }
+    long long visits() const { return visits_; } // child nodes looked at by place()
+    void resetVisits() { visits_ = 0; }
+
+    MemUsage scratchUsage() const;
+
+private:
+    std::vector<int> free_;      // by server index, -1 for null servers
+    std::vector<int> rackOf_;    // server index -> rack node
+
+    // rack r holds servers rackServers_[rackFirst_[r] .. rackFirst_[r+1])
+    std::vector<int> rackFirst_, rackServers_, rackMax_;
+    std::vector<int> podOf_;     // rack node -> pod node
+
+    // pod p holds racks podRacks_[podFirst_[p] .. podFirst_[p+1])
+    std::vector<int> podFirst_, podRacks_, podMax_;
+    int rootMax_ = -1;
+
+    long long visits_ = 0;
+    std::vector<Server*> built_; // servers the grouping was made for ...
+    std::vector<std::pair<int, int>> builtLoc_, scratchLoc_; // ... and their (pod, rack)
+
+    void aggregateRack(int r);
+    void aggregatePod(int p);
+    void aggregateRoot();
+};
+
+#endif // TOPOLOGY_H
@@ -0,0 +1,79 @@
+#include "TopologyScheduler.h"
+#include "Job.h"
+#include "Server.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <iostream>
+
+void TopologyScheduler::runBatch(std::vector<Job*>& jobs,
+                                 std::vector<Server*>& servers,
+                                 int currentTime,
+                                 Simulation* sim)
+{
+    // S1. tree over the current free capacities, server id -> index for homes
+    index_.build(servers);
+    int maxId = 0;
+    for (Server* s : servers) {
+        if (s) maxId = std::max(maxId, s->id());
+    }
+    serverIndexById_.assign(maxId + 1, -1);
+    for (std::size_t si = servers.size(); si-- > 0; ) {
+        if (servers[si]) serverIndexById_[servers[si]->id()] = static_cast<int>(si);
+    }
+
+    // S2. place job by job, re-aggregating only the chosen server's ancestors
+    for (Job* job : jobs) {
+        if (!job || !job->isWaiting()) continue;
+        int demand = job->reportedDemand();
+        if (demand <= 0) continue;
+
+        int home = -1;
+        if (job->numPreferences() > 0) {
+            int sid = job->preferences()[0];
+            if (sid >= 0 && sid <= maxId) home = serverIndexById_[sid];
+        }
+
+        flatScan_ += static_cast<long long>(servers.size());
+        int si = index_.place(demand, home);
+        if (si < 0) continue;
+
+        Server* server = servers[si];
+        if (server->accept(job)) {
+            job->markRunning(currentTime);
+            if (sim) sim->logJobStart(job, server, currentTime);
+
+            ++placed_;
+            if (home < 0) ++remote_;
+            else if (index_.sameRack(si, home)) ++homeRack_;
+            else if (index_.samePod(si, home)) ++homePod_;
+            else ++remote_;
+        } else {
+            job->markFailed(currentTime); // under-reported, does not fit
+        }
+        index_.update(si, server->freeCapacity());
+    }
+}
+
+void TopologyScheduler::resetStats() {
+    placed_   = 0;
+    homeRack_ = 0;
+    homePod_  = 0;
+    remote_   = 0;
+    flatScan_ = 0;
+    index_.resetVisits();
+}
+
+void TopologyScheduler::printStats() const {
+    auto pct = [this](long long n) { return placed_ > 0 ? 100.0 * n / placed_ : 0.0; };
+    std::cout << "Topology: " << index_.numRacks() << " racks in " << index_.numPods()
+              << " pods, placed " << placed_ << " (home rack " << pct(homeRack_)
+              << "%, home pod " << pct(homePod_) << "%, remote " << pct(remote_) << "%), "
+              << index_.visits() << " tree nodes visited vs " << flatScan_ << " for a flat scan\n";
+}
+
+MemUsage TopologyScheduler::scratchUsage() const {
+    MemUsage u = index_.scratchUsage();
+    u.addVector(serverIndexById_);
+    return u;
+}
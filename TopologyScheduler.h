@@ -0,0 +1,44 @@
+#ifndef TOPOLOGY_SCHEDULER_H
+#define TOPOLOGY_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "Simulation.h"
+#include "Topology.h"
+
+#include <vector>
+
+// Locality-aware best-fit through the rack / pod tree (TopologyIndex)
+// - A job's home is the rack and pod of the first server on its preference
+//   list; it lands in its home rack if anything there fits, else in its home
+//   pod, else wherever fits tightest
+// - Placement descends the tree, O(depth x fanout) per job instead of the
+//   O(servers) scan of BaseScheduler
+// - Jobs in arrival order; a job that fits nowhere stays Waiting
+// - Without serversPerRack / racksPerPod all servers share one rack, and this
+//   is plain best-fit
+class TopologyScheduler : public Scheduler {
+public:
+    TopologyScheduler() = default;
+    ~TopologyScheduler() override = default;
+
+    void runBatch(std::vector<Job*>& jobs,
+                  std::vector<Server*>& servers,
+                  int currentTime,
+                  Simulation *sim) override;
+
+    void resetStats() override;
+    void printStats() const override;
+    MemUsage scratchUsage() const override;
+
+private:
+    TopologyIndex index_;
+    std::vector<int> serverIndexById_;
+
+    long long placed_   = 0; // accepted by their server, failed jobs not counted
+    long long homeRack_ = 0; // placed in the home rack
+    long long homePod_  = 0; // in the home pod, another rack
+    long long remote_   = 0; // in another pod
+    long long flatScan_ = 0; // servers a linear best-fit would have looked at
+};
+
+#endif // TOPOLOGY_SCHEDULER_H
@@ -0,0 +1,136 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Trace {
+
+std::atomic<bool> g_enabled(false);
+
+namespace {
+
+struct Event {
+    const char*  name;
+    std::int64_t start; // ns since enable()
+    std::int64_t dur;
+    long long    arg;
+};
+
+// written by its own thread only
+struct ThreadBuffer {
+    int tid = 0;
+    std::string name;
+    std::vector<Event> events;
+    long long dropped = 0;
+};
+
+std::mutex g_mutex; // buffer registry + interned names
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+std::set<std::string> g_names;
+std::size_t g_maxEvents = 0;
+std::chrono::steady_clock::time_point g_epoch;
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer* localBuffer() {
+    if (!t_buffer) {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_buffers.emplace_back(new ThreadBuffer());
+        t_buffer = g_buffers.back().get();
+        t_buffer->tid = static_cast<int>(g_buffers.size());
+        t_buffer->events.reserve(std::min<std::size_t>(g_maxEvents, 4096));
+    }
+    return t_buffer;
+}
+
+void writeEscaped(std::ostream& out, const char* s) {
+    out << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out << '\\';
+        if (static_cast<unsigned char>(*s) < 0x20) continue;
+        out << *s;
+    }
+    out << '"';
+}
+
+} // namespace
+
+void enable(std::size_t maxEventsPerThread) {
+    g_maxEvents = maxEventsPerThread;
+    g_epoch = std::chrono::steady_clock::now();
+    g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void setThreadName(const char* name) {
+    if (enabled()) localBuffer()->name = name;
+}
+
+const char* intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_names.insert(name).first->c_str();
+}
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_epoch).count();
+}
+
+void record(const char* name, std::int64_t startNs, std::int64_t endNs, long long arg) {
+    ThreadBuffer* b = localBuffer();
+    if (b->events.size() >= g_maxEvents) {
+        ++b->dropped;
+        return;
+    }
+    b->events.push_back({name, startNs, endNs - startNs, arg});
+}
+
+// {"traceEvents":[...]}, complete ("X") events in microseconds, one track per thread
+bool writeChromeTrace(const std::string& path) {
+    std::ofstream fout(path);
+    if (!fout) {
+        std::cerr << "Cannot write trace '" << path << "'\n";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    fout << std::fixed << std::setprecision(3);
+    fout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    fout << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"sim\"}}";
+
+    long long spans = 0, dropped = 0;
+    for (const auto& b : g_buffers) {
+        std::string name = b->name.empty() ? "thread " + std::to_string(b->tid) : b->name;
+        fout << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid
+             << ",\"args\":{\"name\":";
+        writeEscaped(fout, name.c_str());
+        fout << "}}";
+
+        for (const Event& e : b->events) {
+            fout << ",\n{\"name\":";
+            writeEscaped(fout, e.name);
+            fout << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid
+                 << ",\"ts\":" << e.start / 1000.0
+                 << ",\"dur\":" << e.dur / 1000.0;
+            if (e.arg >= 0) fout << ",\"args\":{\"n\":" << e.arg << "}";
+            fout << "}";
+        }
+        spans   += static_cast<long long>(b->events.size());
+        dropped += b->dropped;
+    }
+    fout << "\n]}\n";
+
+    std::cout << "[INFO] Trace: " << spans << " spans on " << g_buffers.size()
+              << " threads written to " << path;
+    if (dropped > 0) std::cout << " (" << dropped << " dropped, raise traceMaxEvents)";
+    std::cout << "\n";
+    return static_cast<bool>(fout);
+}
+
+} // namespace Trace
@@ -0,0 +1,62 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Trace：opt-in wall-clock spans (trace=1), written as Chrome trace event JSON
+// at the end of a run, open it in Perfetto (ui.perfetto.dev) or chrome://tracing
+// - every thread appends to its own buffer, registered under a lock the first
+//   time the thread records; recording itself takes no lock
+// - a buffer keeps at most maxEventsPerThread spans, later ones are only counted
+// - disabled, a TRACE_SCOPE costs one relaxed load and a branch
+// - writeChromeTrace() reads all buffers, call it once the recording threads
+//   have been joined
+namespace Trace {
+
+extern std::atomic<bool> g_enabled;
+
+void enable(std::size_t maxEventsPerThread);
+inline bool enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+// label of the calling thread's track
+void setThreadName(const char* name);
+
+// stable copy of a name built at run time, e.g. "run da_truth"; names passed
+// to Scope must outlive the trace
+const char* intern(const std::string& name);
+
+std::int64_t nowNs();
+void record(const char* name, std::int64_t startNs, std::int64_t endNs, long long arg);
+
+// one complete event from construction to destruction, arg < 0 = none
+class Scope {
+public:
+    explicit Scope(const char* name, long long arg = -1)
+        : name_(name), arg_(arg), start_(enabled() ? nowNs() : -1) {}
+    ~Scope() {
+        if (start_ >= 0) record(name_, start_, nowNs(), arg_);
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    void setArg(long long arg) { arg_ = arg; }
+
+private:
+    const char* name_;
+    long long arg_;
+    std::int64_t start_;
+};
+
+// false if the file can't be written
+bool writeChromeTrace(const std::string& path);
+
+} // namespace Trace
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(...) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(__VA_ARGS__)
+
+#endif // TRACE_H
@@ -0,0 +1,443 @@
+#include "Verifier.h"
+#include "DAScheduler.h"
+#include "AuctionScheduler.h"
+#include "Arena.h"
+
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+namespace {
+
+// one matching engine under test
+struct Engine {
+    std::string name;
+    std::function<Matching(const MatchingInstance&, Arena&)> solve;
+};
+
+std::vector<Engine> makeEngines() {
+    std::vector<Engine> engines;
+    engines.push_back({"da", [](const MatchingInstance& inst, Arena& arena) {
+        DAScheduler sched(DAScheduler::Engine::Serial);
+        sched.setPriority(instancePriority(inst));
+        return solveWithScheduler(sched, inst, arena);
+    }});
+    engines.push_back({"da-rounds", [](const MatchingInstance& inst, Arena& arena) {
+        DAScheduler sched(DAScheduler::Engine::Rounds);
+        sched.setPriority(instancePriority(inst));
+        return solveWithScheduler(sched, inst, arena);
+    }});
+    return engines;
+}
+
+// fixed instances in legacy format, checked before the random ones
+const char* const REGRESSION_CASES[] = {
+    // job 0 lists server 1 twice, its last score (9) counts
+    "2 2\n5 5\n3 3 1 1 1 9 2 0\n3 2 1 5 2 5\n",
+    // same with the scores descending: the last one (1) counts, so job 1 wins
+    // server 1; per-slot scoring would keep job 0 there
+    "2 2\n5 5\n3 3 1 9 1 1 2 0\n3 2 1 5 2 5\n",
+};
+
+// auction instances (scores unused): no winner may pay more than its value,
+// L - k at its k-th listed server, plus the last phase's eps
+const char* const AUCTION_CASES[] = {
+    // C fits the leftover at price 0 after A / B's early evictions raised the clock
+    "3 3\n10 1 1\n6 3 1 0 2 0 3 0\n6 3 1 0 2 0 3 0\n4 1 1 0\n",
+};
+
+std::string checkAuctionPayments(const MatchingInstance& inst, Arena& arena) {
+    AuctionScheduler sched;
+    sched.setPaymentLogging(true);
+    arena.reset();
+    solveWithScheduler(sched, inst, arena);
+
+    double eps = 1.0 / (inst.numJobs() + 1);
+    for (const PaymentRecord& r : sched.payments()) {
+        const std::vector<int>& prefs = inst.prefs[r.jobId];
+        int L = static_cast<int>(prefs.size());
+        int k = static_cast<int>(std::find(prefs.begin(), prefs.end(), r.serverId) - prefs.begin());
+        if (k >= L) return "auction: job " + std::to_string(r.jobId) + " placed off its list";
+        if (r.payment > (L - k) + eps + 1e-9) {
+            std::ostringstream why;
+            why << "auction: job " << r.jobId << " pays " << r.payment
+                << " for value " << (L - k) << " at server " << r.serverId;
+            return why.str();
+        }
+    }
+    return "";
+}
+
+// server priority: score desc, then job index asc
+struct Ranked {
+    long long score;
+    int job;
+};
+
+bool rankedBefore(const Ranked& a, const Ranked& b) {
+    if (a.score != b.score) return a.score > b.score;
+    return a.job < b.job;
+}
+
+int drawLogUniform(std::mt19937& rng, int maxVal) {
+    if (maxVal <= 1) return 1;
+    std::uniform_real_distribution<double> u(0.0, std::log(static_cast<double>(maxVal) + 1.0));
+    int v = static_cast<int>(std::exp(u(rng)));
+    return std::min(std::max(v, 1), maxVal);
+}
+
+MatchingInstance randomInstance(std::mt19937& rng,
+                                const GeneratorConfig& gen,
+                                const VerifyConfig& cfg) {
+    MatchingInstance inst;
+    int n = drawLogUniform(rng, cfg.maxServers);
+    int m = drawLogUniform(rng, cfg.maxJobs);
+
+    std::uniform_int_distribution<int> capDist(gen.serverCapMin, gen.serverCapMax);
+    std::uniform_int_distribution<int> demandDist(gen.demandMin, gen.demandMax);
+    std::uniform_int_distribution<int> lenDist(1, n);
+    std::uniform_int_distribution<int> scoreDist(0, std::max(m / 2, 1));
+    bool demandScores = (rng() % 2 == 0);
+
+    inst.capacity.resize(n);
+    for (int s = 0; s < n; ++s) inst.capacity[s] = capDist(rng);
+
+    std::vector<int> order(n);
+    for (int s = 0; s < n; ++s) order[s] = s;
+
+    inst.demand.resize(m);
+    inst.prefs.resize(m);
+    inst.scores.resize(m);
+    for (int j = 0; j < m; ++j) {
+        inst.demand[j] = demandDist(rng);
+        int L = lenDist(rng);
+        // partial Fisher-Yates: first L entries are a random ordered subset
+        for (int k = 0; k < L; ++k) {
+            std::uniform_int_distribution<int> pick(k, n - 1);
+            std::swap(order[k], order[pick(rng)]);
+        }
+        inst.prefs[j].assign(order.begin(), order.begin() + L);
+        if (demandScores) {
+            // DAScheduler's default priority, exercises the serial pass
+            inst.scores[j].assign(L, -static_cast<long long>(inst.demand[j]));
+        } else {
+            // per-server scores with ties, exercises the rank tables
+            inst.scores[j].resize(L);
+            for (auto& sc : inst.scores[j]) sc = scoreDist(rng);
+        }
+    }
+    return inst;
+}
+
+bool demandScores(const MatchingInstance& inst) {
+    for (int j = 0; j < inst.numJobs(); ++j) {
+        for (long long sc : inst.scores[j]) {
+            if (sc != -static_cast<long long>(inst.demand[j])) return false;
+        }
+    }
+    return true;
+}
+
+// empty string = every engine agrees with the reference and all results are stable
+std::string checkInstance(const MatchingInstance& inst,
+                          const std::vector<Engine>& engines,
+                          int threads,
+                          Arena& arena) {
+    std::ostringstream why;
+
+    Matching ref = solveLegacyDA(inst);
+    std::string err = checkFeasible(inst, ref);
+    if (!err.empty()) return "legacy: " + err;
+    // greedy acceptance with sized jobs is only stable when priority follows demand;
+    // with other scores the engines just have to agree with the reference
+    auto blocking = demandScores(inst) ? findBlockingPairs(inst, ref, threads, 1)
+                                       : std::vector<BlockingPair>();
+    if (!blocking.empty()) {
+        why << "legacy: blocking pair job " << blocking[0].job
+            << " server " << blocking[0].server;
+        return why.str();
+    }
+
+    for (const Engine& e : engines) {
+        arena.reset();
+        Matching got = e.solve(inst, arena);
+        err = checkFeasible(inst, got);
+        if (!err.empty()) return e.name + ": " + err;
+        for (int j = 0; j < inst.numJobs(); ++j) {
+            if (got[j] != ref[j]) {
+                why << e.name << ": job " << j << " matched to " << got[j]
+                    << ", legacy says " << ref[j];
+                return why.str();
+            }
+        }
+    }
+    return "";
+}
+
+MatchingInstance removeJobs(const MatchingInstance& inst, int first, int count) {
+    MatchingInstance out = inst;
+    int last = std::min(first + count, inst.numJobs());
+    out.demand.erase(out.demand.begin() + first, out.demand.begin() + last);
+    out.prefs.erase(out.prefs.begin() + first, out.prefs.begin() + last);
+    out.scores.erase(out.scores.begin() + first, out.scores.begin() + last);
+    return out;
+}
+
+MatchingInstance removeServer(const MatchingInstance& inst, int sid) {
+    MatchingInstance out = inst;
+    out.capacity.erase(out.capacity.begin() + sid);
+    for (int j = 0; j < out.numJobs(); ++j) {
+        std::vector<int> prefs;
+        std::vector<long long> scores;
+        for (std::size_t k = 0; k < inst.prefs[j].size(); ++k) {
+            int s = inst.prefs[j][k];
+            if (s == sid) continue;
+            prefs.push_back(s > sid ? s - 1 : s);
+            scores.push_back(inst.scores[j][k]);
+        }
+        out.prefs[j].swap(prefs);
+        out.scores[j].swap(scores);
+    }
+    return out;
+}
+
+// greedy delta debugging: keep any smaller instance that still fails
+MatchingInstance shrinkInstance(MatchingInstance cur,
+                                const std::function<bool(const MatchingInstance&)>& fails) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        // S1. drop chunks of jobs, halving the chunk size
+        for (int chunk = std::max(cur.numJobs() / 2, 1); chunk >= 1; chunk /= 2) {
+            for (int first = 0; first < cur.numJobs(); ) {
+                MatchingInstance cand = removeJobs(cur, first, chunk);
+                if (fails(cand)) {
+                    cur = std::move(cand);
+                    progress = true;
+                } else {
+                    first += chunk;
+                }
+            }
+        }
+
+        // S2. drop servers
+        for (int s = cur.numServers() - 1; s >= 0 && cur.numServers() > 1; --s) {
+            MatchingInstance cand = removeServer(cur, s);
+            if (fails(cand)) {
+                cur = std::move(cand);
+                progress = true;
+            }
+        }
+
+        // S3. drop preference entries
+        for (int j = 0; j < cur.numJobs(); ++j) {
+            for (int k = static_cast<int>(cur.prefs[j].size()) - 1; k >= 0; --k) {
+                MatchingInstance cand = cur;
+                cand.prefs[j].erase(cand.prefs[j].begin() + k);
+                cand.scores[j].erase(cand.scores[j].begin() + k);
+                if (fails(cand)) {
+                    cur = std::move(cand);
+                    progress = true;
+                }
+            }
+        }
+
+        // S4. smaller numbers
+        for (int s = 0; s < cur.numServers(); ++s) {
+            while (cur.capacity[s] > 1) {
+                MatchingInstance cand = cur;
+                cand.capacity[s] = cur.capacity[s] / 2;
+                if (!fails(cand)) break;
+                cur = std::move(cand);
+                progress = true;
+            }
+        }
+        for (int j = 0; j < cur.numJobs(); ++j) {
+            while (cur.demand[j] > 1) {
+                MatchingInstance cand = cur;
+                cand.demand[j] = cur.demand[j] / 2;
+                for (auto& sc : cand.scores[j]) {
+                    if (sc == -static_cast<long long>(cur.demand[j])) sc = -cand.demand[j];
+                }
+                if (!fails(cand)) break;
+                cur = std::move(cand);
+                progress = true;
+            }
+        }
+    }
+    return cur;
+}
+
+} // namespace
+
+std::string checkFeasible(const MatchingInstance& inst, const Matching& match) {
+    std::ostringstream why;
+    if (static_cast<int>(match.size()) != inst.numJobs()) {
+        return "matching has wrong size";
+    }
+    std::vector<long long> used(inst.numServers(), 0);
+    for (int j = 0; j < inst.numJobs(); ++j) {
+        int s = match[j];
+        if (s < 0) continue;
+        if (s >= inst.numServers() ||
+            std::find(inst.prefs[j].begin(), inst.prefs[j].end(), s) == inst.prefs[j].end()) {
+            why << "job " << j << " matched to server " << s << " not on its list";
+            return why.str();
+        }
+        used[s] += inst.demand[j];
+    }
+    for (int s = 0; s < inst.numServers(); ++s) {
+        if (used[s] > inst.capacity[s]) {
+            why << "server " << s << " over capacity (" << used[s] << " > " << inst.capacity[s] << ")";
+            return why.str();
+        }
+    }
+    return "";
+}
+
+std::vector<BlockingPair> findBlockingPairs(const MatchingInstance& inst,
+                                            const Matching& match,
+                                            int threads,
+                                            std::size_t maxReport) {
+    int n = inst.numServers();
+    int m = inst.numJobs();
+
+    // S1. each server: matched jobs in priority order + prefix demand
+    std::vector<std::vector<Ranked>> held(n);
+    for (int j = 0; j < m; ++j) {
+        int s = match[j];
+        if (s < 0) continue;
+        for (std::size_t k = 0; k < inst.prefs[j].size(); ++k) {
+            if (inst.prefs[j][k] == s) {
+                held[s].push_back({inst.scores[j][k], j});
+                break;
+            }
+        }
+    }
+    std::vector<std::vector<long long>> prefix(n);
+    for (int s = 0; s < n; ++s) {
+        std::sort(held[s].begin(), held[s].end(), rankedBefore);
+        prefix[s].assign(held[s].size() + 1, 0);
+        for (std::size_t i = 0; i < held[s].size(); ++i) {
+            prefix[s][i + 1] = prefix[s][i] + inst.demand[held[s][i].job];
+        }
+    }
+
+    // S2. job j blocks with s (ranked above its match) if the greedy rule at s
+    //     would still take j: demand of held jobs ranked above j + demand j fits
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+    threads = std::min(threads, std::max(m / 1024, 1));
+
+    std::vector<std::vector<BlockingPair>> found(threads);
+    auto worker = [&](int t) {
+        int lo = static_cast<int>(static_cast<long long>(m) * t / threads);
+        int hi = static_cast<int>(static_cast<long long>(m) * (t + 1) / threads);
+        for (int j = lo; j < hi && found[t].size() < maxReport; ++j) {
+            for (std::size_t k = 0; k < inst.prefs[j].size(); ++k) {
+                int s = inst.prefs[j][k];
+                if (s == match[j]) break;
+                Ranked me{inst.scores[j][k], j};
+                auto it = std::lower_bound(held[s].begin(), held[s].end(), me, rankedBefore);
+                long long above = prefix[s][it - held[s].begin()];
+                if (above + inst.demand[j] <= inst.capacity[s]) {
+                    found[t].push_back({j, s});
+                    break;
+                }
+            }
+        }
+    };
+
+    if (threads == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+        for (auto& th : pool) th.join();
+    }
+
+    std::vector<BlockingPair> out;
+    for (auto& v : found) {
+        for (auto& bp : v) {
+            if (out.size() >= maxReport) break;
+            out.push_back(bp);
+        }
+    }
+    return out;
+}
+
+int runVerifyMode(const GeneratorConfig& gen, const VerifyConfig& cfg) {
+    std::vector<Engine> engines = makeEngines();
+    std::mt19937 rng(gen.seed);
+    Arena arena;
+
+    std::cout << "=== Verify: " << cfg.instances << " instances, engines: legacy(ref)";
+    for (const Engine& e : engines) std::cout << ", " << e.name;
+    std::cout << " ===\n";
+
+    int failures = 0;
+    long long totalJobs = 0;
+    int regressions = 0;
+    bool shrunk = false;
+    for (const char* text : REGRESSION_CASES) {
+        MatchingInstance inst;
+        std::istringstream in(text);
+        readLegacyInstance(in, inst);
+        totalJobs += inst.numJobs();
+        ++regressions;
+
+        std::string why = checkInstance(inst, engines, cfg.threads, arena);
+        if (why.empty()) continue;
+        ++failures;
+        std::cout << "[FAIL] regression case " << regressions - 1 << ": " << why << "\n";
+    }
+
+    for (const char* text : AUCTION_CASES) {
+        MatchingInstance inst;
+        std::istringstream in(text);
+        readLegacyInstance(in, inst);
+        totalJobs += inst.numJobs();
+        ++regressions;
+
+        std::string why = checkAuctionPayments(inst, arena);
+        if (why.empty()) continue;
+        ++failures;
+        std::cout << "[FAIL] regression case " << regressions - 1 << ": " << why << "\n";
+    }
+
+    for (int i = 0; i < cfg.instances; ++i) {
+        MatchingInstance inst = randomInstance(rng, gen, cfg);
+        totalJobs += inst.numJobs();
+
+        std::string why = checkInstance(inst, engines, cfg.threads, arena);
+        if (why.empty()) continue;
+
+        ++failures;
+        std::cout << "[FAIL] instance " << i << " (" << inst.numJobs() << " jobs, "
+                  << inst.numServers() << " servers): " << why << "\n";
+
+        if (!shrunk && cfg.shrink) {
+            shrunk = true;
+            MatchingInstance small = shrinkInstance(inst, [&](const MatchingInstance& c) {
+                return !checkInstance(c, engines, 1, arena).empty();
+            });
+            std::cout << "       shrunk to " << small.numJobs() << " jobs, "
+                      << small.numServers() << " servers: "
+                      << checkInstance(small, engines, 1, arena) << "\n";
+            std::ofstream out(cfg.reproPath);
+            if (out) {
+                writeLegacyInstance(out, small);
+                std::cout << "       reproducer written to " << cfg.reproPath << "\n";
+            }
+        }
+    }
+
+    std::cout << "Checked " << cfg.instances << " instances + " << regressions
+              << " regression cases (" << totalJobs << " jobs), " << failures << " failing\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+#ifndef VERIFIER_H
+#define VERIFIER_H
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "MatchingInstance.h"
+#include "DataGenerator.h"
+
+struct VerifyConfig {
+    int instances  = 200;   // random instances to check
+    int maxJobs    = 2000;  // instance sizes are drawn log-uniformly up to these
+    int maxServers = 50;
+    int threads    = 0;     // stability checker threads, 0 = hardware_concurrency
+    bool shrink    = true;  // minimize failing instances
+    std::string reproPath = "results/verify_repro.txt";
+};
+
+struct BlockingPair {
+    int job    = -1;
+    int server = -1;
+};
+
+// feasibility: every matched server is on the job's list, no capacity overflow
+// returns an empty string when ok, otherwise a description
+std::string checkFeasible(const MatchingInstance& inst, const Matching& match);
+
+// stability under the servers' greedy choice rule (score desc, job index asc):
+// (j, s) blocks if j prefers s to its match and s, choosing from its matched
+// jobs plus j, would take j. O(jobs x prefs x log) split over 'threads'
+std::vector<BlockingPair> findBlockingPairs(const MatchingInstance& inst,
+                                            const Matching& match,
+                                            int threads,
+                                            std::size_t maxReport = 16);
+
+// differential + stability harness: random instances, every registered
+// engine vs the legacy reference, failing cases shrunk and written to reproPath
+int runVerifyMode(const GeneratorConfig& gen, const VerifyConfig& cfg);
+
+#endif // VERIFIER_H
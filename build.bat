@@ -18,7 +18,30 @@ set SRC= ^
   DataGenerator.cpp ^
   Metrics.cpp ^
   Config.cpp ^
-  ResultWriter.cpp
+  ResultWriter.cpp ^
+  Arena.cpp ^
+  BatchController.cpp ^
+  Daemon.cpp ^
+  MatchingInstance.cpp ^
+  Verifier.cpp ^
+  OptFlowScheduler.cpp ^
+  SchedulerFactory.cpp ^
+  Counterfactual.cpp ^
+  Stats.cpp ^
+  MemStats.cpp ^
+  ServerPriority.cpp ^
+  BatchSolver.cpp ^
+  CapacityIndex.cpp ^
+  EDFScheduler.cpp ^
+  Skyline.cpp ^
+  BackfillScheduler.cpp ^
+  DRFScheduler.cpp ^
+  AuctionScheduler.cpp ^
+  Distributions.cpp ^
+  Topology.cpp ^
+  TopologyScheduler.cpp ^
+  Trace.cpp ^
+  Replicated.cpp
 
 if not exist build (
   mkdir build
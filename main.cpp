@@ -3,24 +3,28 @@
 #include <random>
 #include <chrono>
 #include <iomanip>
+#include <memory>
+#include <sstream>
 
 #include "Config.h"
 #include "DataGenerator.h"
 #include "Simulation.h"
-#include "BaseScheduler.h"
-#include "DAScheduler.h"
+#include "Scheduler.h"
+#include "SchedulerFactory.h"
 #include "Metrics.h"
 #include "Job.h"
 #include "Server.h"
 #include "ResultWriter.h"
-
-template <typename T>
-void freePtrVector(std::vector<T*>& vec) {
-    for (T* p : vec) {
-        delete p;
-    }
-    vec.clear();
-}
+#include "Arena.h"
+#include "Daemon.h"
+#include "Verifier.h"
+#include "BatchSolver.h"
+#include "Counterfactual.h"
+#include "Stats.h"
+#include "MemStats.h"
+#include "AuctionScheduler.h"
+#include "Replicated.h"
+#include "Trace.h"
 
 std::string doubleToString(double value, int precision) {
     std::ostringstream oss;
@@ -28,25 +32,55 @@ std::string doubleToString(double value, int precision) {
     return oss.str();
 }
 
-void freeAllForOneRun(std::vector<Job*>& trueJobs,
-                      std::vector<Job*>& jobsBaseTruth,
-                      std::vector<Job*>& jobsBaseStrat,
-                      std::vector<Job*>& jobsDATruth,
-                      std::vector<Job*>& jobsDAStrat,
-                      std::vector<Server*>& serversBaseTruth,
-                      std::vector<Server*>& serversBaseStrat,
-                      std::vector<Server*>& serversDATruth,
-                      std::vector<Server*>& serversDAStrat) {
-    freePtrVector(trueJobs);
-    freePtrVector(jobsBaseTruth);
-    freePtrVector(jobsBaseStrat);
-    freePtrVector(jobsDATruth);
-    freePtrVector(jobsDAStrat);
-
-    freePtrVector(serversBaseTruth);
-    freePtrVector(serversBaseStrat);
-    freePtrVector(serversDATruth);
-    freePtrVector(serversDAStrat);
+// one (scheduler, reporting) combination run on every seed
+struct Scenario {
+    std::string name;  // scheduler key, e.g. "da"
+    std::string type;  // e.g. "da_strat", used in CSV and file names
+    std::string label; // e.g. "DA Strategic"
+    bool strategic = false;
+    std::unique_ptr<Scheduler> scheduler; // own instance, keeps scratch + stats across seeds
+
+    std::vector<Job*>    jobs;
+    std::vector<Server*> servers;
+    Metrics metrics;
+    std::vector<DeviationSummary> deviations; // counterfactual=1, truthful runs only
+};
+
+// jobs/servers live in the seed's arena, drop the pointers and rewind it
+void freeAllForOneRun(Arena& arena,
+                      std::vector<Job*>& trueJobs,
+                      std::vector<Scenario>& scenarios) {
+    trueJobs.clear();
+    for (Scenario& sc : scenarios) {
+        sc.jobs.clear();
+        sc.servers.clear();
+    }
+    arena.reset();
+}
+
+// same scheduler as `baseline` with the same reporting, nullptr if none / sc is the baseline
+const Scenario* pairedBaselineOf(const Scenario& sc,
+                                 const std::vector<Scenario>& scenarios,
+                                 const std::string& baseline) {
+    if (baseline.empty() || sc.name == baseline) return nullptr;
+    for (const Scenario& other : scenarios) {
+        if (other.name == baseline && other.strategic == sc.strategic) return &other;
+    }
+    return nullptr;
+}
+
+// arena usage since its last reset, diffed around each phase
+MemUsage arenaUsage(const Arena& arena) {
+    MemUsage u;
+    u.allocs = static_cast<long long>(arena.allocations());
+    u.bytes  = static_cast<long long>(arena.bytesUsed());
+    return u;
+}
+
+// trace=1: write what was recorded, then exit with 'code'
+int finishTrace(const RunConfig& rc, int code) {
+    if (rc.trace) Trace::writeChromeTrace(rc.tracePath);
+    return code;
 }
 
 unsigned int generateRandomSeed() {
@@ -72,6 +106,11 @@ int main(int argc, char** argv) {
 
     std::cout << "Loaded config from " << configPath << "\n";
 
+    if (rc.trace) {
+        Trace::enable(static_cast<std::size_t>(rc.traceMaxEvents));
+        Trace::setThreadName("main");
+    }
+
     unsigned int baseSeed;
     if (rc.gen.seed == (unsigned int)(-1)) {  
         baseSeed = generateRandomSeed();
@@ -81,8 +120,111 @@ int main(int argc, char** argv) {
         std::cout << "[INFO] Using configured seed = " << baseSeed << "\n";
     }
 
+    // a score table that doesn't load stops the run instead of ranking by 0s
+    if (!rc.daScoreFile.empty()) {
+        rc.daScores = loadDAScores(rc.daScoreFile);
+        if (!rc.daScores) return 1;
+    }
+
+    if (rc.mode == "daemon") {
+        rc.gen.seed = baseSeed;
+        return finishTrace(rc, runDaemonMode(rc.gen, rc.daemon, rc.batchSize, rc.batch,
+                                             rc.daBudget, rc.daScores) ? 0 : 1);
+    }
+    if (rc.mode == "verify") {
+        rc.gen.seed = baseSeed;
+        return finishTrace(rc, runVerifyMode(rc.gen, rc.verify));
+    }
+    if (rc.mode == "solve") {
+        return finishTrace(rc, runSolveMode(rc.solve));
+    }
+
     bool enableVisualization = (rc.gen.numJobs <= 50 && rc.numSeeds == 1);
 
+    // per-seed storage, reused by every seed
+    Arena arena;
+
+    // scenarios: truthful + strategic for each configured scheduler
+    std::vector<Scenario> scenarios;
+    for (const std::string& name : rc.schedulers) {
+        for (int strategic = 0; strategic <= 1; ++strategic) {
+            Scenario sc;
+            sc.scheduler = makeScheduler(name, rc.daBudget, rc.daScores);
+            if (!sc.scheduler) {
+                if (name == "dascore") {
+                    std::cerr << "schedulers=dascore needs daScoreFile, skipped.\n";
+                } else {
+                    std::cerr << "Unknown scheduler '" << name << "', skipped.\n";
+                }
+                break;
+            }
+            if (auto* auction = dynamic_cast<AuctionScheduler*>(sc.scheduler.get())) {
+                auction->setPaymentLogging(true);
+            }
+            sc.strategic = (strategic == 1);
+            sc.name  = name;
+            sc.type  = name + (sc.strategic ? "_strat" : "_truth");
+            sc.label = schedulerLabel(name) + (sc.strategic ? " Strategic" : " Truthful");
+            scenarios.push_back(std::move(sc));
+        }
+    }
+    if (rc.counterfactual) {
+        for (const Scenario& sc : scenarios) {
+            if (!sc.strategic && !sc.scheduler->replayable()) {
+                std::cerr << "counterfactual=1: " << sc.type << " can't be replayed, skipped.\n";
+            }
+        }
+    }
+
+    std::string configName = configPath;
+    std::string writeFileName;
+    std::string summaryFileName;
+    std::string memoryFileName;
+    std::string deadlineFileName;
+    std::string tenantFileName;
+    std::string workflowFileName;
+    std::string paymentsFileName;
+    if(enableVisualization) { //small case visulization
+        writeFileName   = "results/results_small_case.csv";
+        summaryFileName = "results/summary_small_case.csv";
+        memoryFileName  = "results/memory_small_case.csv";
+        deadlineFileName = "results/deadline_small_case.csv";
+        tenantFileName   = "results/tenants_small_case.csv";
+        workflowFileName = "results/workflow_small_case.csv";
+        paymentsFileName = "results/payments_small_case.csv";
+    } else {
+        std::string suffix = doubleToString(rc.gen.misreportProb, 2) +
+                             "_" +
+                             doubleToString(rc.gen.misreportAlpha, 2) +
+                             ".csv";
+        writeFileName   = "results/results_" + suffix;
+        summaryFileName = "results/summary_" + suffix;
+        memoryFileName  = "results/memory_" + suffix;
+        deadlineFileName = "results/deadline_" + suffix;
+        tenantFileName   = "results/tenants_" + suffix;
+        workflowFileName = "results/workflow_" + suffix;
+        paymentsFileName = "results/payments_" + suffix;
+    }
+
+    if (rc.mode == "lockstep") {
+        return finishTrace(rc, runLockstepMode(rc, baseSeed, configName, writeFileName, summaryFileName));
+    }
+
+    // running cross-seed statistics, nothing kept per seed
+    SeedAggregator agg;
+
+    bool earlyStop = !rc.stopMetrics.empty();
+    int  seedsUsed = 0;
+    bool converged = false;
+    for (const std::string& spec : rc.stopMetrics) {
+        std::string name = spec.substr(spec.find(':') + 1);
+        if (!SeedAggregator::metric(SeedAggregator::Row(), name)) {
+            std::cerr << "Unknown stop metric '" << spec << "', ignored.\n";
+        }
+    }
+
+    MemReport mem(rc.memStats);
+
     for (int s = 0; s < rc.numSeeds; ++s) {
         unsigned int seed = baseSeed + s;
         rc.gen.seed = seed;
@@ -91,96 +233,164 @@ int main(int argc, char** argv) {
 
         DataGenerator gen(rc.gen);
 
+        mem.clear();
+
         // true jobs
+        mem.beginPhase();
+        MemUsage mark = arenaUsage(arena);
         std::vector<Job*> trueJobs;
-        gen.generateTrueJobs(trueJobs);
-
-        // servers for each scheduler / scenario
-        std::vector<Server*> serversBaseTruth;
-        std::vector<Server*> serversBaseStrat;
-        std::vector<Server*> serversDATruth;
-        std::vector<Server*> serversDAStrat;
-
-        gen.generateServers(serversBaseTruth);
-        gen.generateServers(serversBaseStrat);
-        gen.generateServers(serversDATruth);
-        gen.generateServers(serversDAStrat);
-
-        // job variants
-        std::vector<Job*> jobsBaseTruth;
-        std::vector<Job*> jobsBaseStrat;
-        std::vector<Job*> jobsDATruth;
-        std::vector<Job*> jobsDAStrat;
-
-        gen.makeTruthfulCopy(trueJobs, jobsBaseTruth);
-        gen.makeStrategicCopy(trueJobs, jobsBaseStrat);
-        gen.makeTruthfulCopy(trueJobs, jobsDATruth);
-        gen.makeStrategicCopy(trueJobs, jobsDAStrat);
-
-        BaseScheduler baseSched;
-        DAScheduler   daSched;
+        {
+            TRACE_SCOPE("generate", seed);
+            gen.generateTrueJobs(trueJobs, arena);
+        }
+        mem.charge(MEM_GENERATOR, arenaUsage(arena) -= mark);
+        mem.endPhase("generate");
+
+        // servers + job variant for each scheduler / scenario
+        mem.beginPhase();
+        for (Scenario& sc : scenarios) {
+            TRACE_SCOPE("copies");
+            mark = arenaUsage(arena);
+            gen.generateServers(sc.servers, arena);
+            mem.charge(MEM_SERVERS, arenaUsage(arena) -= mark);
+
+            mark = arenaUsage(arena);
+            if (sc.strategic) {
+                gen.makeStrategicCopy(trueJobs, sc.jobs, arena);
+            } else {
+                gen.makeTruthfulCopy(trueJobs, sc.jobs, arena);
+            }
+            mem.charge(MEM_JOBS, arenaUsage(arena) -= mark);
+        }
+        mem.endPhase("copies");
+
         Simulation    sim(rc.timeLimit);
+        sim.setBatchPolicy(rc.batch);
 
-        // ---- Base Truthful ----
-        sim.clearRunRecords();
-        Metrics mBaseTruth = sim.run(baseSched, jobsBaseTruth, serversBaseTruth, rc.batchSize, &sim);
-        if(enableVisualization) sim.dumpRunRecordsToCSV("results/schedule_base_truth.csv", serversBaseTruth);
+        // small case: full Gantt rows; large case: occupancy timeline + sampled rows
+        bool exportTimeline = (rc.exportOccupancy && s == 0);
+        int sampleEvery = 0;
+        if (enableVisualization) {
+            sampleEvery = 1;
+        } else if (exportTimeline) {
+            sampleEvery = rc.jobRecordSampleEvery;
+        }
+        bool dumpRecords = (sampleEvery > 0);
+        sim.setRecordSampling(sampleEvery);
+        sim.setOccupancyTracking(exportTimeline);
 
-        // ---- Base Strategic ----
-        sim.clearRunRecords();
-        Metrics mBaseStrat = sim.run(baseSched, jobsBaseStrat, serversBaseStrat, rc.batchSize, &sim);
-        if(enableVisualization) sim.dumpRunRecordsToCSV("results/schedule_base_strat.csv", serversBaseStrat);
+        for (Scenario& sc : scenarios) {
+            sim.clearRunRecords();
+            sc.scheduler->resetStats();
+            // replays don't track workflow dependencies
+            bool counterfactual = (rc.counterfactual && !sc.strategic && rc.gen.workflowSize <= 1 &&
+                                   sc.scheduler->replayable());
+            sim.setReplayTracing(counterfactual);
+            mem.beginPhase();
+            mark = arenaUsage(arena);
+            {
+                Trace::Scope runScope(Trace::enabled() ? Trace::intern("run " + sc.type) : "run");
+                sc.metrics = sim.run(*sc.scheduler, sc.jobs, sc.servers, rc.batchSize, &sim);
+            }
+            mem.charge(MEM_SERVERS, arenaUsage(arena) -= mark); // assigned-job lists
+            mem.charge(MEM_SCHEDULER, sc.scheduler->scratchUsage());
+            mem.charge(MEM_TRACE, sim.traceUsage());
+            mem.endPhase("run " + sc.type);
 
-        // ---- DA Truthful ----
-        sim.clearRunRecords();
-        Metrics mDATruth = sim.run(daSched, jobsDATruth, serversDATruth, rc.batchSize, &sim);
-        if(enableVisualization) sim.dumpRunRecordsToCSV("results/schedule_da_truth.csv", serversDATruth);
+            if(dumpRecords) sim.dumpRunRecordsToCSV("results/schedule_" + sc.type + ".csv", sc.servers);
+            if(exportTimeline) sim.dumpOccupancyToCSV("results/occupancy_" + sc.type + ".csv", sc.servers);
 
-        // ---- DA Strategic ----
-        sim.clearRunRecords();
-        Metrics mDAStrat = sim.run(daSched, jobsDAStrat, serversDAStrat, rc.batchSize, &sim);
-        if(enableVisualization) sim.dumpRunRecordsToCSV("results/schedule_da_strat.csv", serversDAStrat);
+            // would any single job have done better by lying?
+            sc.deviations.clear();
+            if (counterfactual) {
+                TRACE_SCOPE("counterfactual");
+                std::unique_ptr<Scheduler> replayScheduler = makeScheduler(sc.name, rc.daBudget, rc.daScores);
+                CounterfactualAnalyzer cf(sim, sc.jobs, sc.servers);
+                for (double f : rc.cfFactors) {
+                    sc.deviations.push_back(cf.analyze(*replayScheduler, f,
+                                                       rc.gen.demandMin, rc.gen.demandMax));
+                }
+            }
+        }
 
         sim.clearRunRecords();
 
-        std::cout << "=== Base Truthful ===\n";
-        mBaseTruth.print();
-        std::cout << "\n=== Base Strategic ===\n";
-        mBaseStrat.print();
-        std::cout << "\n=== DA Truthful ===\n";
-        mDATruth.print();
-        std::cout << "\n=== DA Strategic ===\n";
-        mDAStrat.print();
+        for (std::size_t i = 0; i < scenarios.size(); ++i) {
+            std::cout << (i ? "\n" : "") << "=== " << scenarios[i].label << " ===\n";
+            scenarios[i].metrics.print();
+            scenarios[i].scheduler->printStats();
+            for (const DeviationSummary& d : scenarios[i].deviations) {
+                std::cout << "Misreport x" << (1.0 + d.factor) << ": "
+                          << d.improved << "/" << d.jobs << " jobs gain (avg "
+                          << d.avgGain << ", max " << d.maxGain << "), "
+                          << d.worsened << " lose; replayed "
+                          << d.ticksReplayed << " of " << d.ticksFull << " ticks\n";
+            }
+        }
+        if (mem.enabled()) {
+            mem.beginPhase();
+            freeAllForOneRun(arena, trueJobs, scenarios);
+            mem.endPhase("free");
+            mem.print();
+        } else {
+            freeAllForOneRun(arena, trueJobs, scenarios);
+        }
         std::cout << "\n";
 
-        freeAllForOneRun(trueJobs,
-                        jobsBaseTruth,
-                        jobsBaseStrat,
-                        jobsDATruth,
-                        jobsDAStrat,
-                        serversBaseTruth,
-                        serversBaseStrat,
-                        serversDATruth,
-                        serversDAStrat);
-
-        std::string configName;
-        std::string writeFileName;
-        if(enableVisualization) { //small case visulization
-            configName = configPath;
-            writeFileName = "results/results_small_case.csv";
-        } else {
-            configName = configPath;
-            writeFileName = "results/results_" + 
-                            doubleToString(rc.gen.misreportProb, 2) +
-                            "_" +
-                            doubleToString(rc.gen.misreportAlpha, 2) +
-                            ".csv";
-        }   
-        ResultWriter::writeCSV(writeFileName, configName, "base_truth", seed, mBaseTruth);
-        ResultWriter::writeCSV(writeFileName, configName, "base_strat", seed, mBaseStrat);
-        ResultWriter::writeCSV(writeFileName, configName, "da_truth",   seed, mDATruth);
-        ResultWriter::writeCSV(writeFileName, configName, "da_strat",   seed, mDAStrat);
-    }
-
-    return 0;
+        for (const Scenario& sc : scenarios) {
+            agg.add(sc.type, sc.metrics);
+            const Scenario* base = pairedBaselineOf(sc, scenarios, rc.pairedBaseline);
+            if (base) agg.addPaired(sc.type, sc.metrics, base->type, base->metrics);
+        }
+
+        {
+            TRACE_SCOPE("write csv");
+            for (const Scenario& sc : scenarios) {
+                if (rc.perSeedRows) {
+                    ResultWriter::writeCSV(writeFileName, configName, sc.type, seed, sc.metrics);
+                }
+                if (rc.gen.deadlineProb > 0.0) {
+                    ResultWriter::writeDeadlineCSV(deadlineFileName, configName, sc.type, seed, sc.metrics);
+                }
+                if (sc.metrics.workflows > 0) {
+                    ResultWriter::writeWorkflowCSV(workflowFileName, configName, sc.type, seed, sc.metrics);
+                }
+                if (sc.metrics.tenants.size() > 1) {
+                    ResultWriter::writeTenantCSV(tenantFileName, configName, sc.type, seed, sc.metrics);
+                }
+                if (auto* auction = dynamic_cast<const AuctionScheduler*>(sc.scheduler.get())) {
+                    ResultWriter::writePaymentsCSV(paymentsFileName, configName, sc.type, seed,
+                                                   auction->payments());
+                }
+                for (const DeviationSummary& d : sc.deviations) {
+                    ResultWriter::writeCounterfactualCSV("results/counterfactual.csv",
+                                                         configName, sc.type, seed, d);
+                }
+            }
+            if (mem.enabled()) {
+                ResultWriter::writeMemoryCSV(memoryFileName, configName, seed, mem);
+            }
+        }
+
+        ++seedsUsed;
+        if (earlyStop && agg.converged(rc.stopMetrics, rc.stopCiAbs, rc.stopCiRel, rc.minSeeds)) {
+            converged = true;
+            break;
+        }
+    }
+
+    if (earlyStop) {
+        std::cout << "[INFO] Early stopping: " << seedsUsed << " of " << rc.numSeeds << " seeds used ("
+                  << (converged ? "converged" : "budget exhausted") << ")\n";
+    }
+    if (seedsUsed > 1) {
+        std::cout << "===== Summary over " << seedsUsed << " seeds (mean +- 95% CI) =====\n";
+        agg.print();
+    }
+    {
+        TRACE_SCOPE("summary csv");
+        ResultWriter::writeSummaryCSV(summaryFileName, configName, agg);
+    }
+
+    return finishTrace(rc, 0);
 }
@@ -0,0 +1,70 @@
+import pandas as pd
+import matplotlib.pyplot as plt
+import numpy as np
+
+# occupancy_*.csv: one row per run of a server's step function
+#   used capacity == used on [startTime, endTime)
+# written when exportOccupancy=1 in the config
+
+
+def plot_occupancy(csv_path, title, out_png=None):
+    df = pd.read_csv(csv_path)
+
+    servers = sorted(df["serverId"].unique())
+    caps = df.groupby("serverId")["serverCap"].first()
+
+    fig, ax = plt.subplots(figsize=(14, 6))
+
+    y_ticks = []
+    y_labels = []
+
+    server_gap = 2
+    current_y = 0
+
+    for sid in servers:
+        sub = df[df["serverId"] == sid].sort_values("startTime")
+        cap = caps[sid]
+
+        # step function, one point per run instead of one bar per job
+        x = np.append(sub["startTime"].values, sub["endTime"].values[-1])
+        y = np.append(sub["used"].values, sub["used"].values[-1])
+
+        ax.fill_between(x, current_y, current_y + y, step="post", alpha=0.6)
+        ax.hlines(current_y + cap, x[0], x[-1], colors="black", linewidth=0.5, linestyles="--")
+
+        y_ticks.append(current_y + cap / 2)
+        y_labels.append(f"Server {sid}")
+
+        current_y += cap + server_gap
+
+    ax.set_xlabel("Time")
+    ax.set_yticks(y_ticks)
+    ax.set_yticklabels(y_labels)
+    ax.set_title(title)
+    ax.grid(True, axis="x", linestyle="--", alpha=0.4)
+
+    # total utilization: expand runs to per-tick usage with a difference array
+    t_max = int(df["endTime"].max())
+    delta = np.zeros(t_max + 1)
+    np.add.at(delta, df["startTime"].values, df["used"].values)
+    np.add.at(delta, df["endTime"].values, -df["used"].values)
+    used = np.cumsum(delta)[:t_max]
+    util = used / caps.sum()
+
+    ax2 = ax.twinx()
+    ax2.plot(np.arange(t_max), util, color="black", linewidth=1.5, label="Utilization")
+    ax2.set_ylabel("Total utilization")
+    ax2.set_ylim(0, 1.05)
+    ax2.legend(loc="upper right")
+
+    plt.tight_layout()
+    if out_png:
+        plt.savefig(out_png, dpi=150)
+    plt.show()
+
+
+if __name__ == "__main__":
+    plot_occupancy("results/occupancy_base_truth.csv",  "Base Truthful",  "graphs/occupancy_base_truth.png")
+    plot_occupancy("results/occupancy_base_strat.csv",  "Base Strategic", "graphs/occupancy_base_strat.png")
+    plot_occupancy("results/occupancy_da_truth.csv",    "DA Truthful",    "graphs/occupancy_da_truth.png")
+    plot_occupancy("results/occupancy_da_strat.csv",    "DA Strategic",   "graphs/occupancy_da_strat.png")